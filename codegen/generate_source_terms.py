@@ -0,0 +1,266 @@
+"""
+Generate the \\pi^{\\mu\\nu} / \\Pi source-term kernel used by src/hydro/SourceTerms.cpp.
+
+The relaxation equations are written down symbolically below (the same algebra as
+mathematica/equations.nb, in (tau,x,y,eta_s)-coordinates), reduced with common
+subexpression elimination and printed as a single inline C++ function.
+
+All tau-dependent factors (t, t^2, t^3 and their inverses) and 1/dt are inputs,
+so they are computed once per Euler step instead of once per cell, and the kernel
+contains no divisions at all (1/u^tau is passed in as well).
+
+The relaxation terms -\\pi^{\\mu\\nu}/\\tau_\\pi and -\\Pi/\\tau_\\Pi are left out; they are
+stiff and are integrated by the caller (see EXPONENTIAL_RELAXATION in SourceTerms.h).
+
+usage:
+	python3 codegen/generate_source_terms.py > src/hydro/PimunuSourceTermsGenerated.h
+	python3 codegen/generate_source_terms.py --stats
+"""
+import sys
+import sympy as sp
+from sympy.printing.c import C99CodePrinter
+
+#==========================================================================================
+# inputs
+#==========================================================================================
+# proper time factors (hoisted, see PROPER_TIME_FACTORS in SourceTerms.h)
+t, t2, t3, tInv, t2Inv, t3Inv, dtInv = sp.symbols('tf->t tf->t2 tf->t3 tf->tInv tf->t2Inv tf->t3Inv tf->dtInv')
+# fluid velocity at the current and previous time step
+ut, ux, uy, un = sp.symbols('ut ux uy un')
+utp, uxp, uyp, unp = sp.symbols('utp uxp uyp unp')
+# dissipative currents
+pitt, pitx, pity, pitn, pixx, pixy, pixn, piyy, piyn, pinn, Pi = sp.symbols(
+	'pitt pitx pity pitn pixx pixy pixn piyy piyn pinn Pi')
+# spatial derivatives of u^\mu
+dxut, dyut, dnut = sp.symbols('dxut dyut dnut')
+dxux, dyux, dnux = sp.symbols('dxux dyux dnux')
+dxuy, dyuy, dnuy = sp.symbols('dxuy dyuy dnuy')
+dxun, dyun, dnun = sp.symbols('dxun dyun dnun')
+dkvk = sp.Symbol('dkvk')
+# transport coefficients (evaluated by the caller)
+beta_pi, beta_Pi, lambda_Pipi = sp.symbols('beta_pi beta_Pi lambda_Pipi')
+# second order coefficients (file scope constants in SourceTerms.cpp)
+delta_pipi, tau_pipi, delta_PiPi, lambda_piPi = sp.symbols('delta_pipi tau_pipi delta_PiPi lambda_piPi')
+
+# kept symbolic so that sympy does not distribute 1/2 and 1/3 over every sum
+half = sp.Symbol('HALF')
+third = sp.Symbol('THIRD')
+
+#==========================================================================================
+# kinematics
+#==========================================================================================
+ut2 = ut*ut
+un2 = un*un
+
+# time derivatives of u
+dtut = (ut - utp)*dtInv
+dtux = (ux - uxp)*dtInv
+dtuy = (uy - uyp)*dtInv
+dtun = (un - unp)*dtInv
+
+# covariant derivatives
+Dut = ut*dtut + ux*dxut + uy*dyut + un*dnut + t*un*un
+Dux = -(ut*dtux + ux*dxux + uy*dyux + un*dnux)
+Duy = -(ut*dtuy + ux*dxuy + uy*dyuy + un*dnuy)
+Dun = -t2*(ut*dtun + ux*dxun + uy*dyun + un*dnun + 2*ut*un*tInv)
+
+dut = Dut - t*un*un
+dux = ut*dtux + ux*dxux + uy*dyux + un*dnux
+duy = ut*dtuy + ux*dxuy + uy*dyuy + un*dnuy
+dun = ut*dtun + ux*dxun + uy*dyun + un*dnun
+
+# expansion rate
+theta = ut*tInv + dtut + dxux + dyuy + dnun
+
+# shear tensor
+stt = -t*ut*un2 + (dtut - ut*dut) + (ut2 - 1)*theta*third
+stx = -(t*un2*ux)*half + (dtux - dxut)*half - (ux*dut + ut*dux)*half + ut*ux*theta*third
+sty = -(t*un2*uy)*half + (dtuy - dyut)*half - (uy*dut + ut*duy)*half + ut*uy*theta*third
+stn = -un*(2*ut2 + t2*un2)*tInv*half + (dtun - dnut*t2Inv)*half - (un*dut + ut*dun)*half + ut*un*theta*third
+sxx = -(dxux + ux*dux) + (1 + ux*ux)*theta*third
+sxy = -(dxuy + dyux)*half - (uy*dux + ux*duy)*half + ux*uy*theta*third
+sxn = -ut*ux*un*tInv - (dxun + dnux*t2Inv)*half - (un*dux + ux*dun)*half + ux*un*theta*third
+syy = -(dyuy + uy*duy) + (1 + uy*uy)*theta*third
+syn = -ut*uy*un*tInv - (dyun + dnuy*t2Inv)*half - (un*duy + uy*dun)*half + uy*un*theta*third
+snn = -ut*(1 + 2*t2*un2)*t3Inv - dnun*t2Inv - un*dun + (t2Inv + un2)*theta*third
+
+# vorticity tensor
+wtx = (dtux + dxut)*half + (ux*dut - ut*dux)*half + t*un2*ux*half
+wty = (dtuy + dyut)*half + (uy*dut - ut*duy)*half + t*un2*uy*half
+wtn = (t2*dtun + 2*t*un + dnut)*half + (t2*un*dut - ut*Dun) + t3*un*un2*half
+wxy = (dyux - dxuy)*half + (uy*dux - ux*duy)*half
+wxn = (dnux - t2*dxun)*half + (t2*un*dux - ux*Dun)*half
+wyn = (dnuy - t2*dyun)*half + (t2*un*duy - uy*Dun)*half
+wxt = wtx
+wyt = wty
+wnt = wtn*t2Inv
+wyx = -wxy
+wnx = -wxn*t2Inv
+wny = -wyn*t2Inv
+
+#==========================================================================================
+# second order terms
+#==========================================================================================
+I1tt = 2*ut*(pitt*Dut + pitx*Dux + pity*Duy + pitn*Dun)
+I1tx = (pitt*ux + pitx*ut)*Dut + (pitx*ux + pixx*ut)*Dux + (pity*ux + pixy*ut)*Duy + (pitn*ux + pixn*ut)*Dun
+I1ty = (pitt*uy + pity*ut)*Dut + (pitx*uy + pixy*ut)*Dux + (pity*uy + piyy*ut)*Duy + (pitn*uy + piyn*ut)*Dun
+I1tn = (pitt*un + pitn*ut)*Dut + (pitx*un + pixn*ut)*Dux + (pity*un + piyn*ut)*Duy + (pitn*un + pinn*ut)*Dun
+I1xx = 2*ux*(pitx*Dut + pixx*Dux + pixy*Duy + pixn*Dun)
+I1xy = (pitx*uy + pity*ux)*Dut + (pixx*uy + pixy*ux)*Dux + (pixy*uy + piyy*ux)*Duy + (pixn*uy + piyn*ux)*Dun
+I1xn = (pitx*un + pitn*ux)*Dut + (pixx*un + pixn*ux)*Dux + (pixy*un + piyn*ux)*Duy + (pixn*un + pinn*ux)*Dun
+I1yy = 2*uy*(pity*Dut + pixy*Dux + piyy*Duy + piyn*Dun)
+I1yn = (pity*un + pitn*uy)*Dut + (pixy*un + pixn*uy)*Dux + (piyy*un + piyn*uy)*Duy + (piyn*un + pinn*uy)*Dun
+I1nn = 2*un*(pitn*Dut + pixn*Dux + piyn*Duy + pinn*Dun)
+
+I3tt = 2*(pitx*wtx + pity*wty + pitn*wtn)
+I3tx = pitt*wxt + pity*wxy + pitn*wxn + pixx*wtx + pixy*wty + pixn*wtn
+I3ty = pitt*wyt + pitx*wyx + pitn*wyn + pixy*wtx + piyy*wty + piyn*wtn
+I3tn = pitt*wnt + pitx*wnx + pity*wny + pixn*wtx + piyn*wty + pinn*wtn
+I3xx = 2*(pitx*wxt + pixy*wxy + pixn*wxn)
+I3xy = pitx*wyt + pity*wxt + pixx*wyx + piyy*wxy + pixn*wyn + piyn*wxn
+I3xn = pitx*wnt + pitn*wxt + pixx*wnx + pixy*wny + piyn*wxy + pinn*wxn
+I3yy = 2*(pity*wyt + pixy*wyx + piyn*wyn)
+I3yn = pity*wnt + pitn*wyt + pixy*wnx + pixn*wyx + piyy*wny + pinn*wyn
+I3nn = 2*(pitn*wnt + pixn*wnx + piyn*wny)
+
+ps = (pitt*stt - 2*pitx*stx - 2*pity*sty + pixx*sxx + 2*pixy*sxy + piyy*syy
+	- 2*pitn*stn*t2 + 2*pixn*sxn*t2 + 2*piyn*syn*t2 + pinn*snn*t2*t2)
+
+I4tt = (pitt*stt - pitx*stx - pity*sty - t2*pitn*stn) - (1 - ut2)*ps*third
+I4tx = ((pitt*stx + pitx*stt)*half - (pitx*sxx + pixx*stx)*half - (pity*sxy + pixy*sty)*half
+	- t2*(pitn*sxn + pixn*stn)*half + (ut*ux)*ps*third)
+I4ty = ((pitt*sty + pity*stt)*half - (pitx*sxy + pixy*stx)*half - (pity*syy + piyy*sty)*half
+	- t2*(pitn*syn + piyn*stn)*half + (ut*uy)*ps*third)
+I4tn = ((pitt*stn + pitn*stt)*half - (pitx*sxn + pixn*stx)*half - (pity*syn + piyn*sty)*half
+	- t2*(pitn*snn + pinn*stn)*half + (ut*un)*ps*third)
+I4xx = (pitx*stx - pixx*sxx - pixy*sxy - t2*pixn*sxn) + (1 + ux*ux)*ps*third
+I4xy = ((pitx*sty + pity*stx)*half - (pixx*sxy + pixy*sxx)*half - (pixy*syy + piyy*sxy)*half
+	- t2*(pixn*syn + piyn*sxn)*half + (ux*uy)*ps*third)
+I4xn = ((pitx*stn + pitn*stx)*half - (pixx*sxn + pixn*sxx)*half - (pixy*syn + piyn*sxy)*half
+	- t2*(pixn*snn + pinn*sxn)*half + (ux*un)*ps*third)
+I4yy = (pity*sty - pixy*sxy - piyy*syy - t2*piyn*syn) + (1 + uy*uy)*ps*third
+I4yn = ((pity*stn + pitn*sty)*half - (pixy*sxn + pixn*sxy)*half - (piyy*syn + piyn*syy)*half
+	- t2*(piyn*snn + pinn*syn)*half + (uy*un)*ps*third)
+I4nn = (pitn*stn - pixn*sxn - piyn*syn - t2*pinn*snn) + (t2Inv + un2)*ps*third
+
+def I(I1, pi, I3, I4, s):
+	return I1 + delta_pipi*theta*pi - I3 + tau_pipi*I4 - lambda_piPi*Pi*s
+
+Itt = I(I1tt, pitt, I3tt, I4tt, stt)
+Itx = I(I1tx, pitx, I3tx, I4tx, stx)
+Ity = I(I1ty, pity, I3ty, I4ty, sty)
+Itn = I(I1tn, pitn, I3tn, I4tn, stn)
+Ixx = I(I1xx, pixx, I3xx, I4xx, sxx)
+Ixy = I(I1xy, pixy, I3xy, I4xy, sxy)
+Ixn = I(I1xn, pixn, I3xn, I4xn, sxn)
+Iyy = I(I1yy, piyy, I3yy, I4yy, syy)
+Iyn = I(I1yn, piyn, I3yn, I4yn, syn)
+Inn = I(I1nn, pinn, I3nn, I4nn, snn)
+
+#==========================================================================================
+# right hand sides
+#==========================================================================================
+dpitt = 2*beta_pi*stt - Itt - 2*un*t*pitn
+dpitx = 2*beta_pi*stx - Itx - un*t*pixn
+dpity = 2*beta_pi*sty - Ity - un*t*piyn
+dpitn = 2*beta_pi*stn - Itn - un*t*pinn - (ut*pitn + un*pitt)*tInv
+dpixx = 2*beta_pi*sxx - Ixx
+dpixy = 2*beta_pi*sxy - Ixy
+dpixn = 2*beta_pi*sxn - Ixn - (ut*pixn + un*pitx)*tInv
+dpiyy = 2*beta_pi*syy - Iyy
+dpiyn = 2*beta_pi*syn - Iyn - (ut*piyn + un*pity)*tInv
+dpinn = 2*beta_pi*snn - Inn - 2*(ut*pinn + un*pitn)*tInv
+
+dPi = -beta_Pi*theta - delta_PiPi*Pi*theta + lambda_Pipi*ps
+
+utInv = sp.Symbol('utInv')
+shear = [(dpitt, pitt), (dpitx, pitx), (dpity, pity), (dpitn, pitn), (dpixx, pixx),
+	(dpixy, pixy), (dpixn, pixn), (dpiyy, piyy), (dpiyn, piyn), (dpinn, pinn)]
+rhs_shear = [d*utInv + p*dkvk for d, p in shear]
+rhs_bulk = [dPi*utInv + Pi*dkvk]
+
+#==========================================================================================
+# code generation
+#==========================================================================================
+class KernelPrinter(C99CodePrinter):
+	"""C printer that never emits pow() or divisions by variables."""
+	def _print_Pow(self, expr):
+		b, e = expr.as_base_exp()
+		if e.is_Integer and 1 < e <= 4:
+			return '*'.join([self.parenthesize(b, sp.printing.precedence.PRECEDENCE['Mul'])] * int(e))
+		raise ValueError('unexpected power in source terms: %s' % expr)
+
+	def _print_Rational(self, expr):
+		return '(%d.0/%d.0)' % (expr.p, expr.q)
+
+	def _print_Symbol(self, expr):
+		if expr == half:
+			return '0.5'
+		if expr == third:
+			return '(1.0/3.0)'
+		return super()._print_Symbol(expr)
+
+def count_flops(exprs):
+	ops = sp.count_ops(exprs, visual=True)
+	counts = {}
+	for term in sp.Add.make_args(ops):
+		coeff, sym = term.as_coeff_Mul()
+		counts[str(sym)] = counts.get(str(sym), 0) + int(coeff)
+	# a - b is printed as one subtraction and -a*b as one multiplication
+	flops = counts.get('ADD', 0) + counts.get('SUB', 0) + counts.get('MUL', 0) + counts.get('DIV', 0)
+	return flops, counts
+
+def generate():
+	replacements, reduced = sp.cse(rhs_shear + rhs_bulk, symbols=sp.numbered_symbols('x'))
+	flops, counts = count_flops([r for _, r in replacements] + reduced)
+	return replacements, reduced, flops, counts
+
+def print_kernel(replacements, reduced, flops):
+	printer = KernelPrinter()
+	out = []
+	out.append('/*')
+	out.append(' * PimunuSourceTermsGenerated.h')
+	out.append(' *')
+	out.append(' * GENERATED by codegen/generate_source_terms.py -- do not edit by hand,')
+	out.append(' * regenerate with `make sources`.')
+	out.append(' *')
+	out.append(' * %d common subexpressions, %d floating point operations per cell.' % (len(replacements), flops))
+	out.append(' */')
+	out.append('')
+	out.append('#ifndef PIMUNUSOURCETERMSGENERATED_H_')
+	out.append('#define PIMUNUSOURCETERMSGENERATED_H_')
+	out.append('')
+	out.append('#include "../hydro/DynamicalVariables.h"')
+	out.append('#include "../hydro/SourceTerms.h"')
+	out.append('')
+	out.append('static inline void pimunuSourceTermsKernel(PRECISION * const __restrict__ pimunuRHS,')
+	out.append('\t\tconst PROPER_TIME_FACTORS * const __restrict__ tf,')
+	out.append('\t\tPRECISION ut, PRECISION ux, PRECISION uy, PRECISION un, PRECISION utp, PRECISION uxp, PRECISION uyp, PRECISION unp, PRECISION utInv,')
+	out.append('\t\tPRECISION pitt, PRECISION pitx, PRECISION pity,')
+	out.append('\t\tPRECISION pitn, PRECISION pixx, PRECISION pixy, PRECISION pixn, PRECISION piyy,')
+	out.append('\t\tPRECISION piyn, PRECISION pinn, PRECISION Pi,')
+	out.append('\t\tPRECISION dxut, PRECISION dyut, PRECISION dnut, PRECISION dxux, PRECISION dyux, PRECISION dnux,')
+	out.append('\t\tPRECISION dxuy, PRECISION dyuy, PRECISION dnuy, PRECISION dxun, PRECISION dyun, PRECISION dnun, PRECISION dkvk,')
+	out.append('\t\tPRECISION beta_pi, PRECISION beta_Pi, PRECISION lambda_Pipi')
+	out.append(') {')
+	for sym, expr in replacements:
+		out.append('\tconst PRECISION %s = %s;' % (sym, printer.doprint(expr)))
+	for n, expr in enumerate(reduced[:10]):
+		out.append('\tpimunuRHS[%d] = %s;' % (n, printer.doprint(expr)))
+	out.append('#ifdef PI')
+	out.append('\tpimunuRHS[10] = %s;' % printer.doprint(reduced[10]))
+	out.append('#endif')
+	out.append('}')
+	out.append('')
+	out.append('#endif /* PIMUNUSOURCETERMSGENERATED_H_ */')
+	return '\n'.join(out) + '\n'
+
+if __name__ == '__main__':
+	replacements, reduced, flops, counts = generate()
+	if '--stats' in sys.argv:
+		naive, _ = count_flops(rhs_shear + rhs_bulk)
+		print('expression tree without CSE : %d flops' % naive)
+		print('generated kernel            : %d flops (%d subexpressions)' % (flops, len(replacements)))
+		print('                              ' + ', '.join('%s=%d' % kv for kv in sorted(counts.items())))
+	else:
+		sys.stdout.write(print_kernel(replacements, reduced, flops))
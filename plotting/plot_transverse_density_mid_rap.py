@@ -2,29 +2,42 @@ import numpy as np
 import matplotlib.pyplot as plt
 import sys
 
+from snapshot_file import read_snapshots, field, times, coordinates
+
+# usage: plot_transverse_density_mid_rap.py output/snapshots.bin [tau]
+#        plot_transverse_density_mid_rap.py output/e_<tau>.dat nx ny nz   (ASCII output, outputFormat=0)
 plt.style.use('classic')
 filename = sys.argv[1]
 
-nx = int(sys.argv[2])
-ny = int(sys.argv[3])
-nz = int(sys.argv[4])
-
-dx = 0.1
-dy = 0.1
-dz = 0.5
-
-xmax = dx*((nx-1)/2)
-ymax = dy*((ny-1)/2)
-x, y, z, v = np.loadtxt(filename, unpack=True)
-
-xnew = np.linspace(-xmax, xmax, num=nx)
-ynew = np.linspace(-ymax, ymax, num=ny)
-
-vnew = v.reshape(nz, ny, nx).transpose()
+if filename.endswith('.bin'):
+    header, snapshots = read_snapshots(filename)
+    nz = header['nz']
+    xnew, ynew, z = coordinates(header)
+    # the snapshot closest to tau, the last one by default
+    index = -1
+    if len(sys.argv) > 2:
+        index = int(np.argmin(np.abs(times(snapshots, 'e') - float(sys.argv[2]))))
+    tau, v = field(header, snapshots, 'e', index)
+    vnew = v.transpose()
+else:
+    nx = int(sys.argv[2])
+    ny = int(sys.argv[3])
+    nz = int(sys.argv[4])
+
+    dx = 0.1
+    dy = 0.1
+    x, y, z, v = np.loadtxt(filename, unpack=True)
+    vnew = v.reshape(nz, ny, nx).transpose()
+
+    xmax = dx*((nx-1)/2)
+    ymax = dy*((ny-1)/2)
+
+    xnew = np.linspace(-xmax, xmax, num=nx)
+    ynew = np.linspace(-ymax, ymax, num=ny)
 
 front = vnew[:, :, 0].transpose()
 back = vnew[:, :, -1].transpose()
-middle = vnew[:, :, ((nz-1)/2)].transpose()
+middle = vnew[:, :, ((nz-1)//2)].transpose()
 
 fig, ax = plt.subplots()
 cset1 = ax.pcolormesh(xnew, ynew, middle)
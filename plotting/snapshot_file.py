@@ -0,0 +1,117 @@
+"""Reader for the binary snapshots of the fluid written by cpu-vh according to
+the output plan (outputFormat 1 and 2 in output.properties, see
+src/io/SnapshotFile.h for the layout): snapshots.bin, one file per run, or
+snapshot_<tau>.bin.
+
+The snapshots are memory mapped, so only the fields and times that are used
+are read from disk. A file that is still being written can be read; an
+incomplete last snapshot is left out.
+
+usage: python snapshot_file.py output/snapshots.bin
+"""
+
+import struct
+import sys
+
+import numpy as np
+
+MAGIC = b'CPUVHSNP'
+SUPPORTED_VERSION = 2
+
+
+class Snapshot(object):
+    """A snapshot: its time tau and a dict of the fields in it, each a
+    memory mapped array values[nz, ny, nx]."""
+
+    def __init__(self, tau, fields):
+        self.tau = tau
+        self.fields = fields
+
+    def __getitem__(self, name):
+        return self.fields[name]
+
+
+def read_snapshots(filename):
+    """Return (header, snapshots): a dict with the cells and the field names,
+    and a list of Snapshot in the order of the file."""
+    with open(filename, 'rb') as f:
+        if f.read(8) != MAGIC:
+            raise ValueError('%s is not a snapshot file' % filename)
+        fields = f.read(32)
+        # the byte order of the file follows from the 0x01020304 marker
+        for order in '<>':
+            version, marker, nx, ny, nz, value_size, nfields, names_length = struct.unpack(order + '8i', fields)
+            if marker == 0x01020304:
+                break
+        else:
+            raise ValueError('%s: unknown byte order' % filename)
+        if version > SUPPORTED_VERSION:
+            raise ValueError('%s: version %d is newer than this reader' % (filename, version))
+        if version == 1:
+            dx, dy, dz = struct.unpack(order + '3d', f.read(24))
+            x0, y0, z0 = (-(n - 1) / 2.0 * d for n, d in ((nx, dx), (ny, dy), (nz, dz)))
+        else:
+            x0, y0, z0, dx, dy, dz = struct.unpack(order + '6d', f.read(48))
+        names = f.read(names_length)[:-1].decode('ascii').split()
+        offset = f.tell()
+        f.seek(0, 2)
+        size = f.tell()
+
+    header = {'version': version, 'nx': nx, 'ny': ny, 'nz': nz, 'x0': x0, 'y0': y0, 'z0': z0,
+              'dx': dx, 'dy': dy, 'dz': dz, 'fields': names}
+    snapshots = []
+    if size == offset:
+        return header, snapshots
+    data = np.memmap(filename, dtype=np.uint8, mode='r')
+    value_type = np.dtype(order + {4: 'f4', 8: 'f8'}[value_size])
+    field_size = nx * ny * nz * value_type.itemsize
+    while True:
+        # version 1 has all the fields in each snapshot, version 2 a bit per field that is in it
+        prefix = 8 if version == 1 else 16
+        if offset + prefix > size:
+            break
+        tau = float(np.frombuffer(data, order + 'f8', 1, offset)[0])
+        if version == 1:
+            present = names
+        else:
+            mask = int(np.frombuffer(data, order + 'u8', 1, offset + 8)[0])
+            present = [name for i, name in enumerate(names) if mask >> i & 1]
+        if offset + prefix + len(present) * field_size > size:
+            break
+        values = {}
+        for i, name in enumerate(present):
+            start = offset + prefix + i * field_size
+            values[name] = np.frombuffer(data, value_type, nx * ny * nz, start).reshape(nz, ny, nx)
+        snapshots.append(Snapshot(tau, values))
+        offset += prefix + len(present) * field_size
+    return header, snapshots
+
+
+def coordinates(header):
+    """Return the x, y and eta coordinates of the cells."""
+    return [header[a + '0'] + np.arange(header['n' + b]) * header['d' + b]
+            for a, b in (('x', 'x'), ('y', 'y'), ('z', 'z'))]
+
+
+def times(snapshots, name):
+    """Return the times of the snapshots with field name."""
+    return np.array([s.tau for s in snapshots if name in s.fields])
+
+
+def field(header, snapshots, name, index=-1):
+    """Return (tau, values[nz, ny, nx]) of field name in the index-th of the
+    snapshots that have it."""
+    snapshot = [s for s in snapshots if name in s.fields][index]
+    return snapshot.tau, np.asarray(snapshot[name])
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    header, snapshots = read_snapshots(sys.argv[1])
+    x, y, z = coordinates(header)
+    print('%d x %d x %d cells in [%g, %g] x [%g, %g] x [%g, %g], fields %s' % (header['nx'], header['ny'], header['nz'],
+          x[0], x[-1], y[0], y[-1], z[0], z[-1], ' '.join(header['fields'])))
+    for snapshot in snapshots:
+        print('tau = %.3f fm: ' % snapshot.tau +
+              ', '.join('max %s = %g' % (name, snapshot[name].max()) for name in header['fields'] if name in snapshot.fields))
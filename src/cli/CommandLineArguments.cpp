@@ -20,6 +20,7 @@ static struct argp_option options[] =
 		{"hydro",  'h', "RUN_HYDRO", OPTION_ARG_OPTIONAL, "Run hydrodynamic simulation"},
 		{"output",  'o', "OUTPUT_DIRECTORY", 0, "Path to output directory"},
 		{"config", 'c', "CONFIG_DIRECTORY", 0, "Path to configuration directory"},
+		{"restart", 'r', "CHECKPOINT_FILE", 0, "Resume the hydrodynamic simulation from a checkpoint"},
 		{0}
 };
 
@@ -45,6 +46,9 @@ parse_opt(int key, char *arg, struct argp_state *state) {
 	case 'c':
 		cli->configDirectory = arg;
 		break;
+	case 'r':
+		cli->restartFile = arg;
+		break;
 //	case ARGP_KEY_ARG:
 //		if (state->arg_num >= 2) {
 //			argp_usage(state);
@@ -99,6 +103,7 @@ error_t loadCommandLineArguments(int argc, char **argv, void * cli_params, const
 	cli->runHydro = false;
 	cli->outputDirectory = NULL;
 	cli->configDirectory = NULL;
+	cli->restartFile = NULL;
 
   /* Where the magic happens */
   argp_parse (&argp, argc, argv, 0, 0, cli);
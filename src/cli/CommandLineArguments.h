@@ -18,6 +18,7 @@ struct CommandLineArguments
   bool runHydro;
   char *configDirectory;              /* The -v flag */
   char *outputDirectory;            /* Argument for -o */
+  char *restartFile;              /* Argument for -r */
 };
 
 error_t loadCommandLineArguments(int argc, char **argv, void * cli_params, const char *version, const char *address);
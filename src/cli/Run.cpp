@@ -20,6 +20,8 @@
 #include "../lattice/LatticeParameters.h"
 #include "../ic/InitialConditionParameters.h"
 #include "../hydro/HydroParameters.h"
+#include "../freezeout/SpectraParameters.h"
+#include "../io/OutputParameters.h"
 #include "../hydro/HydroPlugin.h"
 
 const char *version = "";
@@ -30,8 +32,9 @@ int runTest(int argc, char **argv) {
 	return RUN_ALL_TESTS();
 }
 */
-void runHydro(void * latticeParams, void * initCondParams, void * hydroParams, const char *rootDirectory, const char *outputDir) {
-	run(latticeParams, initCondParams, hydroParams, rootDirectory, outputDir);
+void runHydro(void * latticeParams, void * initCondParams, void * hydroParams, void * spectraParams, void * outputParams,
+		const char *rootDirectory, const char *outputDir, const char *restartFile) {
+	run(latticeParams, initCondParams, hydroParams, spectraParams, outputParams, rootDirectory, outputDir, restartFile);
 }
 
 int main(int argc, char **argv) {
@@ -40,6 +43,8 @@ int main(int argc, char **argv) {
 	struct LatticeParameters latticeParams;
 	struct InitialConditionParameters initCondParams;
 	struct HydroParameters hydroParams;
+	struct SpectraParameters spectraParams;
+	struct OutputParameters outputParams;
 
 	loadCommandLineArguments(argc, argv, &cli, version, address);
 
@@ -50,6 +55,8 @@ int main(int argc, char **argv) {
 	// Print argument values
 	printf("configDirectory = %s\n", cli.configDirectory);
 	printf("outputDirectory = %s\n", cli.outputDirectory);
+	if (cli.restartFile)
+		printf("restartFile = %s\n", cli.restartFile);
 	if (cli.runHydro)
 		printf("runHydro = True\n");
 	else
@@ -62,7 +69,7 @@ int main(int argc, char **argv) {
 	//=========================================
 	// Set parameters from configuration files
 	//=========================================
-	config_t latticeConfig, initCondConfig, hydroConfig;
+	config_t latticeConfig, initCondConfig, hydroConfig, spectraConfig, outputConfig;
 
 	// Set lattice parameters from configuration file
 	config_init(&latticeConfig);
@@ -76,6 +83,14 @@ int main(int argc, char **argv) {
 	config_init(&hydroConfig);
 	loadHydroParameters(&hydroConfig, cli.configDirectory, &hydroParams);
 	config_destroy (&hydroConfig);
+	// Set particle spectra parameters from configuration file
+	config_init(&spectraConfig);
+	loadSpectraParameters(&spectraConfig, cli.configDirectory, &spectraParams);
+	config_destroy(&spectraConfig);
+	// Set output plan from configuration file
+	config_init(&outputConfig);
+	loadOutputParameters(&outputConfig, cli.configDirectory, &outputParams);
+	config_destroy(&outputConfig);
 
 	//=========================================
 	// Run tests
@@ -90,7 +105,8 @@ int main(int argc, char **argv) {
 	// Run hydro
 	//=========================================
 	if (cli.runHydro) {
-		runHydro(&latticeParams, &initCondParams, &hydroParams, rootDirectory, cli.outputDirectory);
+		runHydro(&latticeParams, &initCondParams, &hydroParams, &spectraParams, &outputParams, rootDirectory, cli.outputDirectory,
+				cli.restartFile);
 		printf("Done hydro.\n");
 	}
 
@@ -145,6 +145,54 @@ PRECISION effectiveTemperature(PRECISION e) {
 #endif
 }
 
+void temperatureAndSpeedOfSoundSquared(PRECISION e, PRECISION * const __restrict__ T, PRECISION * const __restrict__ cs2) {
+#ifndef CONFORMAL_EOS
+	// the fits of effectiveTemperature and speedOfSoundSquared, with the powers of e computed once
+	double e1 = (double) e;
+	double e2 = e * e1;
+	double e3 = e2 * e1;
+	double e4 = e3 * e1;
+	double e5 = e4 * e1;
+	double e6 = e5 * e1;
+	double e7 = e6 * e1;
+	double e8 = e7 * e1;
+	double e9 = e8 * e1;
+	double e10 = e9 * e1;
+	double e11 = e10 * e1;
+	double e12 = e11 * e1;
+	double e13 = e12 * e1;
+	*T = (1.510073201405604e-29 + 8.014062800678687e-18 * e
+			+ 2.4954778310451065e-10 * e2 + 0.000063810382643387 * e3
+			+ 0.4873490574161924 * e4 + 207.48582344326206 * e5
+			+ 6686.07424325115 * e6 + 14109.766109389702 * e7
+			+ 1471.6180520527757 * e8 + 14.055788949565482 * e9
+			+ 0.015421252394182246 * e10 + 1.5780479034557783e-6 * e11)
+			/ (7.558667139355393e-28 + 1.3686372302041508e-16 * e
+					+ 2.998130743142826e-9 * e2 + 0.0005036835870305458 * e3
+					+ 2.316902328874072 * e4 + 578.0778724946719 * e5
+					+ 11179.193315394154 * e6 + 17965.67607192861 * e7
+					+ 1051.0730543534657 * e8 + 5.916312075925817 * e9
+					+ 0.003778342768228011 * e10 + 1.8472801679382593e-7 * e11);
+	*cs2 = (5.191934309650155e-32 + 4.123605749683891e-23 * e
+			+ 3.1955868410879504e-16 * e2 + 1.4170364808063119e-10 * e3
+			+ 6.087136671592452e-6 * e4 + 0.02969737949090831 * e5
+			+ 15.382615282179595 * e6 + 460.6487249985994 * e7
+			+ 1612.4245252438795 * e8 + 275.0492627924299 * e9
+			+ 58.60283714484669 * e10 + 6.504847576502024 * e11
+			+ 0.03009027913262399 * e12 + 8.189430244031285e-6 * e13)
+			/ (1.4637868900982493e-30 + 6.716598285341542e-22 * e
+					+ 3.5477700458515908e-15 * e2 + 1.1225580509306008e-9 * e3
+					+ 0.00003551782901018317 * e4 + 0.13653226327408863 * e5
+					+ 60.85769171450653 * e6 + 1800.5461219450308 * e7
+					+ 15190.225535036281 * e8 + 590.2572000057821 * e9
+					+ 293.99144775704605 * e10 + 21.461303090563028 * e11
+					+ 0.09301685073435291 * e12 + 0.000024810902623582917 * e13);
+#else
+	*T = effectiveTemperature(e);
+	*cs2 = speedOfSoundSquared(e);
+#endif
+}
+
 PRECISION equilibriumEnergyDensity(PRECISION T) {
 #ifndef CONFORMAL_EOS
 	// Effective temperature from the Wuppertal-Budapest collaboration
@@ -200,3 +248,12 @@ PRECISION equilibriumEnergyDensity(PRECISION T) {
 #endif
 }
 
+void equilibriumTemperatureAndPressure(const PRECISION * const __restrict__ e, PRECISION * const __restrict__ T,
+		PRECISION * const __restrict__ p, int n) {
+	// the rational function of the temperature vectorizes; the fma chain of the pressure is only
+	// vectorized where fma is a hardware instruction
+	#pragma omp simd
+	for(int i = 0; i < n; ++i) T[i] = effectiveTemperature(e[i]);
+	#pragma omp simd
+	for(int i = 0; i < n; ++i) p[i] = equilibriumPressure(e[i]);
+}
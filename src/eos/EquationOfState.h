@@ -20,8 +20,16 @@ PRECISION equilibriumPressure(PRECISION e);
 
 PRECISION speedOfSoundSquared(PRECISION e);
 
+#pragma omp declare simd
 PRECISION effectiveTemperature(PRECISION e);
 
 PRECISION equilibriumEnergyDensity(PRECISION T);
 
+// effectiveTemperature and speedOfSoundSquared of e, with the same results, from one evaluation of the powers of e
+void temperatureAndSpeedOfSoundSquared(PRECISION e, PRECISION * const __restrict__ T, PRECISION * const __restrict__ cs2);
+
+// effectiveTemperature and equilibriumPressure of n energy densities, with the same results as the scalar functions
+void equilibriumTemperatureAndPressure(const PRECISION * const __restrict__ e, PRECISION * const __restrict__ T,
+		PRECISION * const __restrict__ p, int n);
+
 #endif /* EQUATIONOFSTATE_H_ */
@@ -0,0 +1,252 @@
+/*
+ * CooperFrye.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+#include "../freezeout/CooperFrye.h"
+#include "../freezeout/FreezeoutSurfaceFile.h"
+
+#define HBARC 0.197326938 // [GeV fm]
+
+// the hadrons whose spectra can be evaluated; masses from the PDG
+static const HADRON hadronTable[] = {
+	{"pi+", 211, 0.13957, 1, -1},
+	{"pi-", -211, 0.13957, 1, -1},
+	{"pi0", 111, 0.13498, 1, -1},
+	{"K+", 321, 0.49368, 1, -1},
+	{"K-", -321, 0.49368, 1, -1},
+	{"K0", 311, 0.49761, 1, -1},
+	{"anti-K0", -311, 0.49761, 1, -1},
+	{"eta", 221, 0.54786, 1, -1},
+	{"rho0", 113, 0.77526, 3, -1},
+	{"omega", 223, 0.78266, 3, -1},
+	{"phi", 333, 1.01946, 3, -1},
+	{"p", 2212, 0.93827, 2, 1},
+	{"anti-p", -2212, 0.93827, 2, 1},
+	{"n", 2112, 0.93957, 2, 1},
+	{"anti-n", -2112, 0.93957, 2, 1},
+	{"Lambda", 3122, 1.11568, 2, 1},
+	{"anti-Lambda", -3122, 1.11568, 2, 1},
+	{"Sigma+", 3222, 1.18937, 2, 1},
+	{"Sigma-", 3112, 1.19745, 2, 1},
+	{"Delta++", 2224, 1.232, 4, 1},
+	{"Xi-", 3312, 1.32171, 2, 1},
+	{"anti-Xi+", -3312, 1.32171, 2, 1},
+	{"Omega-", 3334, 1.67245, 4, 1},
+	{"anti-Omega+", -3334, 1.67245, 4, 1},
+};
+
+void initializeCooperFryeSpectra(COOPER_FRYE_SPECTRA * const cf, void * spectraParams) {
+	struct SpectraParameters * params = (struct SpectraParameters *) spectraParams;
+
+	cf->numberOfHadrons = params->numberOfHadrons;
+	for(int h = 0; h < cf->numberOfHadrons; ++h) {
+		int found = 0;
+		for(size_t i = 0; i < sizeof(hadronTable) / sizeof(hadronTable[0]); ++i) {
+			if(strcmp(hadronTable[i].name, params->hadrons[h]) == 0) {
+				cf->hadrons[h] = hadronTable[i];
+				found = 1;
+				break;
+			}
+		}
+		if(!found) {
+			printf("Unknown hadron %s in spectra.properties!\n", params->hadrons[h]);
+			exit(-1);
+		}
+	}
+	cf->shearCorrection = params->shearCorrection;
+
+	cf->npT = params->numberOfTransverseMomenta > 0 ? params->numberOfTransverseMomenta : 1;
+	cf->nphi = params->numberOfAzimuthalAngles > 0 ? params->numberOfAzimuthalAngles : 1;
+	cf->ny = params->numberOfRapidities > 0 ? params->numberOfRapidities : 1;
+	cf->pT = (double *)malloc(cf->npT * sizeof(double));
+	cf->phi = (double *)malloc(cf->nphi * sizeof(double));
+	cf->cosPhi = (double *)malloc(cf->nphi * sizeof(double));
+	cf->sinPhi = (double *)malloc(cf->nphi * sizeof(double));
+	cf->y = (double *)malloc(cf->ny * sizeof(double));
+	for(int i = 0; i < cf->npT; ++i) {
+		cf->pT[i] = params->minTransverseMomentumGeV;
+		if(cf->npT > 1) cf->pT[i] += i * (params->maxTransverseMomentumGeV - params->minTransverseMomentumGeV) / (cf->npT - 1);
+	}
+	// uniform in [0, 2 pi), for which the sum over the angles integrates the harmonics exactly
+	for(int i = 0; i < cf->nphi; ++i) {
+		cf->phi[i] = 2 * M_PI * i / cf->nphi;
+		cf->cosPhi[i] = cos(cf->phi[i]);
+		cf->sinPhi[i] = sin(cf->phi[i]);
+	}
+	for(int i = 0; i < cf->ny; ++i) {
+		cf->y[i] = params->minRapidity;
+		if(cf->ny > 1) cf->y[i] += i * (params->maxRapidity - params->minRapidity) / (cf->ny - 1);
+	}
+
+	cf->size = (size_t)cf->numberOfHadrons * cf->ny * cf->npT * cf->nphi;
+	for(int g = 0; g < COOPER_FRYE_GROUPS; ++g) {
+		cf->groupSpectra[g] = (double *)calloc(cf->size, sizeof(double));
+		cf->groupScratch[g] = (double *)malloc(2 * cf->nphi * sizeof(double));
+		cf->groupElements[g] = 0;
+	}
+	cf->spectra = (double *)calloc(cf->size, sizeof(double));
+	cf->numberOfElements = 0;
+}
+
+void addCooperFryeElements(COOPER_FRYE_SPECTRA * const cf, int group, const double * const elements, int nelements) {
+	double * const __restrict__ spectra = cf->groupSpectra[group];
+	double * const __restrict__ damping = cf->groupScratch[group];
+	double * const __restrict__ dampingStep = damping + cf->nphi;
+	const double * const __restrict__ cosPhi = cf->cosPhi;
+	const double * const __restrict__ sinPhi = cf->sinPhi;
+	const int npT = cf->npT, nphi = cf->nphi, ny = cf->ny;
+	const double dpT = npT > 1 ? cf->pT[1] - cf->pT[0] : 0;
+
+	for(int i = 0; i < nelements; ++i) {
+		const double * const element = elements + i * FREEZEOUT_SURFACE_COLUMNS;
+		const double tau = element[0], eta = element[3];
+		const double tau2 = tau * tau;
+		const double dst = element[4], dsx = element[5], dsy = element[6], dsn = element[7];
+		const double ut = element[8], ux = element[9], uy = element[10], un = element[11];
+		const double T = element[13] * HBARC; // [GeV]
+		const double invT = 1 / T;
+		const double pitt = element[15], pitx = element[16], pity = element[17], pitn = element[18];
+		const double pixx = element[19], pixy = element[20], pixn = element[21];
+		const double piyy = element[22], piyn = element[23], pinn = element[24];
+		// \delta f = (1 - a f) p_\mu p_\nu \pi^{\mu\nu} / (2 T^2 (e+P)), p in [GeV] and \pi, e+P in [fm^-4]
+		const double shearScale = cf->shearCorrection ? 1 / (2 * T * T * (element[12] + element[14])) : 0;
+
+		// p.u/T = (p^\tau u^\tau - \tau^2 p^\eta u^\eta)/T - p_T (u^x cos(phi) + u^y sin(phi))/T: the exponential of the
+		// transverse term is the same for all hadrons and rapidities and, on the uniform p_T grid, is the one of the
+		// previous p_T times that of the step, so that the loop over phi does not evaluate any exponential
+		for(int k = 0; k < nphi; ++k) {
+			const double w = (ux * cosPhi[k] + uy * sinPhi[k]) * invT;
+			damping[k] = exp(-cf->pT[0] * w);
+			dampingStep[k] = exp(-dpT * w);
+		}
+		for(int ipT = 0; ipT < npT; ++ipT) {
+			const double pT = cf->pT[ipT];
+			if(ipT > 0) {
+				#pragma omp simd
+				for(int k = 0; k < nphi; ++k) damping[k] *= dampingStep[k];
+			}
+			for(int h = 0; h < cf->numberOfHadrons; ++h) {
+				const HADRON * const hadron = &cf->hadrons[h];
+				const double mT = sqrt(hadron->mass * hadron->mass + pT * pT);
+				const double a = hadron->statistics;
+				// g/(2 pi)^3, with p.d\sigma in [GeV fm^3] converted to [GeV^-2]
+				const double prefactor = hadron->degeneracy / (8 * M_PI * M_PI * M_PI * HBARC * HBARC * HBARC);
+				for(int iy = 0; iy < ny; ++iy) {
+					// p^\tau and p^\eta do not depend on phi, so their terms are taken out of the loop
+					const double ptau = mT * cosh(cf->y[iy] - eta);
+					const double peta = mT * sinh(cf->y[iy] - eta) / tau;
+					const double pdsigma0 = ptau * dst + peta * dsn;
+					const double longitudinal = exp((ptau * ut - tau2 * peta * un) * invT);
+					// p_\mu p_\nu \pi^{\mu\nu} = S0 + p^x Sx + p^y Sy + p^x p^x \pi^xx + 2 p^x p^y \pi^xy + p^y p^y \pi^yy
+					// with the lowered p_x = -p^x, p_y = -p^y, p_\eta = -\tau^2 p^\eta
+					const double S0 = ptau * ptau * pitt - 2 * tau2 * ptau * peta * pitn + tau2 * tau2 * peta * peta * pinn;
+					const double Sx = -2 * ptau * pitx + 2 * tau2 * peta * pixn;
+					const double Sy = -2 * ptau * pity + 2 * tau2 * peta * piyn;
+					double * const __restrict__ dN = spectra + (((size_t)h * ny + iy) * npT + ipT) * nphi;
+					#pragma omp simd
+					for(int k = 0; k < nphi; ++k) {
+						const double px = pT * cosPhi[k];
+						const double py = pT * sinPhi[k];
+						const double pdsigma = pdsigma0 + px * dsx + py * dsy;
+						const double f = 1 / (longitudinal * damping[k] + a);
+						const double pipp = S0 + px * Sx + py * Sy + px * px * pixx + 2 * px * py * pixy + py * py * piyy;
+						// the correction is limited to |\delta f| <= f, so that f stays positive; clamped with fabs, since
+						// comparisons keep the loop from being vectorized
+						const double df = (1 - a * f) * pipp * shearScale;
+						dN[k] += prefactor * pdsigma * f * (1 + 0.5 * (fabs(df + 1) - fabs(df - 1)));
+					}
+				}
+			}
+		}
+	}
+	cf->groupElements[group] += nelements;
+}
+
+void reduceCooperFryeSpectra(COOPER_FRYE_SPECTRA * const cf, int ngroups) {
+	for(int g = 0; g < ngroups; ++g) {
+		if(cf->groupElements[g] == 0) continue;
+		double * const s = cf->groupSpectra[g];
+		for(size_t i = 0; i < cf->size; ++i) cf->spectra[i] += s[i];
+		cf->numberOfElements += cf->groupElements[g];
+		memset(s, 0, cf->size * sizeof(double));
+		cf->groupElements[g] = 0;
+	}
+}
+
+void cooperFryeFilePath(char *path, const char *directory, const char *name, int numberOfSurfaces, double temperatureGeV) {
+	if(numberOfSurfaces > 1) sprintf(path, "%s/%s_T%gMeV.dat", directory, name, 1000*temperatureGeV);
+	else sprintf(path, "%s/%s.dat", directory, name);
+}
+
+static FILE * openCooperFryeFile(const char *path) {
+	FILE *file = fopen(path, "w");
+	if(!file) {
+		printf("Could not open the spectra file %s!\n", path);
+		exit(-1);
+	}
+	return file;
+}
+
+void writeCooperFryeSpectra(const COOPER_FRYE_SPECTRA * const cf, const char *path) {
+	FILE *file = openCooperFryeFile(path);
+	fprintf(file, "# E dN/d^3p of the hadrons on the freezeout surface (%ld elements)\n", cf->numberOfElements);
+	fprintf(file, "# mcid y pT[GeV] phi E_dN/d^3p[GeV^-2]\n");
+	for(int h = 0; h < cf->numberOfHadrons; ++h)
+		for(int iy = 0; iy < cf->ny; ++iy)
+			for(int ipT = 0; ipT < cf->npT; ++ipT)
+				for(int k = 0; k < cf->nphi; ++k)
+					fprintf(file, "%d %g %g %g %.8e\n", cf->hadrons[h].mcid, cf->y[iy], cf->pT[ipT], cf->phi[k],
+						cf->spectra[(((size_t)h * cf->ny + iy) * cf->npT + ipT) * cf->nphi + k]);
+	fclose(file);
+}
+
+void writeCooperFryeFlow(const COOPER_FRYE_SPECTRA * const cf, const char *path) {
+	FILE *file = openCooperFryeFile(path);
+	fprintf(file, "# yields and flow coefficients v_n = <cos(n phi)> of the hadrons on the freezeout surface (%ld elements)\n",
+		cf->numberOfElements);
+	fprintf(file, "# mcid y dN/dy <pT>[GeV] v1 v2 v3 v4\n");
+	const double dphi = 2 * M_PI / cf->nphi;
+	for(int h = 0; h < cf->numberOfHadrons; ++h) {
+		for(int iy = 0; iy < cf->ny; ++iy) {
+			// dN/dy = \int p_T dp_T dphi E dN/d^3p, by the trapezoidal rule in p_T
+			double dNdy = 0, pTsum = 0, vn[5] = {0, 0, 0, 0, 0};
+			for(int ipT = 0; ipT < cf->npT; ++ipT) {
+				double w = 1;
+				if(cf->npT > 1) {
+					w = (ipT == 0) ? cf->pT[1] - cf->pT[0] : ((ipT == cf->npT - 1) ? cf->pT[ipT] - cf->pT[ipT-1] : cf->pT[ipT+1] - cf->pT[ipT-1]);
+					w *= 0.5;
+				}
+				w *= cf->pT[ipT] * dphi;
+				const double * const s = cf->spectra + (((size_t)h * cf->ny + iy) * cf->npT + ipT) * cf->nphi;
+				for(int k = 0; k < cf->nphi; ++k) {
+					dNdy += w * s[k];
+					pTsum += w * cf->pT[ipT] * s[k];
+					for(int n = 1; n <= 4; ++n) vn[n] += w * cos(n * cf->phi[k]) * s[k];
+				}
+			}
+			double norm = dNdy != 0 ? 1 / dNdy : 0;
+			fprintf(file, "%d %g %.8e %.8e %.8e %.8e %.8e %.8e\n", cf->hadrons[h].mcid, cf->y[iy], dNdy, pTsum * norm,
+				vn[1] * norm, vn[2] * norm, vn[3] * norm, vn[4] * norm);
+		}
+	}
+	fclose(file);
+}
+
+void freeCooperFryeSpectra(COOPER_FRYE_SPECTRA * const cf) {
+	for(int g = 0; g < COOPER_FRYE_GROUPS; ++g) {
+		free(cf->groupSpectra[g]);
+		free(cf->groupScratch[g]);
+	}
+	free(cf->spectra);
+	free(cf->pT);
+	free(cf->phi);
+	free(cf->cosPhi);
+	free(cf->sinPhi);
+	free(cf->y);
+}
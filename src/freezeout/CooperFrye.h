@@ -0,0 +1,70 @@
+/*
+ * CooperFrye.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef COOPERFRYE_H_
+#define COOPERFRYE_H_
+
+#include <stddef.h>
+
+#include "../freezeout/SpectraParameters.h"
+
+// a hadron of the table in CooperFrye.cpp
+typedef struct
+{
+	const char *name;
+	int mcid; // Monte Carlo particle number
+	double mass; // [GeV]
+	double degeneracy;
+	int statistics; // +1 fermion, -1 boson, 0 Boltzmann
+} HADRON;
+
+// thermal spectra E dN/d^3p of the hadrons on one freezeout surface, by the Cooper-Frye formula
+//		E dN/d^3p = g/(2 pi)^3 \sum_elements p^\mu d\sigma_\mu f(p.u/T) (1 + \delta f)
+// with the 14-moment shear correction \delta f = (1 - a f) p_\mu p_\nu \pi^{\mu\nu} / (2 T^2 (e+P)), on a grid
+// of (y, p_T, phi). The elements are added by the threads of the freezeout finder as they are found. Each search
+// of the finder splits its elements into at most COOPER_FRYE_GROUPS groups in a fixed order, whose accumulators are
+// added to the spectra in that order once the search is done, so that the spectra depend neither on the number of
+// threads nor on how the groups were scheduled
+#define COOPER_FRYE_GROUPS 64
+
+typedef struct
+{
+	int numberOfHadrons;
+	HADRON hadrons[MAX_SPECTRA_HADRONS];
+	int shearCorrection;
+	int npT, nphi, ny;
+	double *pT, *phi, *y; // the grid [GeV], [1], [1]
+	double *cosPhi, *sinPhi;
+	size_t size; // numberOfHadrons * ny * npT * nphi, phi fastest
+	double *groupSpectra[COOPER_FRYE_GROUPS]; // E dN/d^3p [GeV^-2] added by each group of the current search
+	double *groupScratch[COOPER_FRYE_GROUPS]; // 2 * nphi values for each group
+	long groupElements[COOPER_FRYE_GROUPS];
+	double *spectra; // the sum over the searches
+	long numberOfElements;
+} COOPER_FRYE_SPECTRA;
+
+void initializeCooperFryeSpectra(COOPER_FRYE_SPECTRA * const cf, void * spectraParams);
+
+// adds the contribution of nelements surface elements of FREEZEOUT_SURFACE_COLUMNS values each (see
+// FreezeoutSurfaceFile.h) to the accumulator of group; a group is added to by one thread at a time
+void addCooperFryeElements(COOPER_FRYE_SPECTRA * const cf, int group, const double * const elements, int nelements);
+
+// adds the accumulators of groups 0 .. ngroups-1 to spectra in this order, and clears them
+void reduceCooperFryeSpectra(COOPER_FRYE_SPECTRA * const cf, int ngroups);
+
+// path of the spectra ("spectra") and flow ("flow") files in directory, e.g. spectra.dat; when several isotherms
+// are extracted, their files are told apart by the temperature, e.g. spectra_T155MeV.dat
+void cooperFryeFilePath(char *path, const char *directory, const char *name, int numberOfSurfaces, double temperatureGeV);
+
+// E dN/d^3p on the grid, one line per point: mcid y pT phi E dN/d^3p
+void writeCooperFryeSpectra(const COOPER_FRYE_SPECTRA * const cf, const char *path);
+
+// the integrated yields and flow coefficients, one line per hadron and rapidity: mcid y dN/dy <pT> v1 v2 v3 v4
+void writeCooperFryeFlow(const COOPER_FRYE_SPECTRA * const cf, const char *path);
+
+void freeCooperFryeSpectra(COOPER_FRYE_SPECTRA * const cf);
+
+#endif /* COOPERFRYE_H_ */
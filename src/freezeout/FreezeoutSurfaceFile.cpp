@@ -0,0 +1,216 @@
+/*
+ * FreezeoutSurfaceFile.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <signal.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <zlib.h>
+
+#include "../freezeout/FreezeoutSurfaceFile.h"
+
+// size of the stdio/zlib buffer in front of the file, so that the filesystem sees large writes
+#define FREEZEOUT_FILE_BUFFER_SIZE (4 << 20)
+// a stream is flushed after each search of the finder, so its buffer only needs to hold about a pipe's worth
+#define FREEZEOUT_STREAM_BUFFER_SIZE (64 << 10)
+
+static const char * const freezeoutSurfaceSchema =
+	"tau[fm] x[fm] y[fm] eta[1] "
+	"dsigma_tau[fm^3] dsigma_x[fm^3] dsigma_y[fm^3] dsigma_eta[fm^4] "
+	"u^tau[1] u^x[1] u^y[1] u^eta[fm^-1] "
+	"e[fm^-4] T[fm^-1] P[fm^-4] "
+	"pi^tautau[fm^-4] pi^taux[fm^-4] pi^tauy[fm^-4] pi^taueta[fm^-5] pi^xx[fm^-4] pi^xy[fm^-4] pi^xeta[fm^-5] "
+	"pi^yy[fm^-4] pi^yeta[fm^-5] pi^etaeta[fm^-6] "
+	"Pi[fm^-4]";
+
+void freezeoutSurfaceFilePath(char *path, const char *directory, int format, int numberOfSurfaces, double temperatureGeV) {
+	const char *extension = ".dat";
+	if(format == FREEZEOUT_FORMAT_BINARY) extension = ".bin";
+	else if(format == FREEZEOUT_FORMAT_BINARY_GZIP) extension = ".bin.gz";
+	if(numberOfSurfaces > 1) sprintf(path, "%s/surface_T%gMeV%s", directory, 1000*temperatureGeV, extension);
+	else sprintf(path, "%s/surface%s", directory, extension);
+}
+
+static void writeBytes(FREEZEOUT_SURFACE_FILE * const surface, const void *bytes, size_t size) {
+	if(size == 0) return;
+	int ok;
+	if(surface->format == FREEZEOUT_FORMAT_BINARY_GZIP)
+		ok = gzwrite((gzFile)surface->gzfile, bytes, (unsigned)size) == (int)size;
+	else
+		ok = fwrite(bytes, 1, size, surface->file) == size;
+	if(!ok) {
+		printf("Error writing the freezeout surface file!\n");
+		exit(-1);
+	}
+}
+
+// connects to a consumer listening on the Unix domain socket path; -1 on failure
+static int connectFreezeoutSocket(const char *path) {
+	struct sockaddr_un address;
+	if(strlen(path) >= sizeof(address.sun_path)) return -1;
+	memset(&address, 0, sizeof(address));
+	address.sun_family = AF_UNIX;
+	strcpy(address.sun_path, path);
+	int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(fd < 0) return -1;
+	if(connect(fd, (struct sockaddr *)&address, sizeof(address)) != 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+// opens the file at path, a new one with the header of the format, or with append an existing one to which the
+// elements are appended
+static void openSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface, const char *path, int format, int dim, int append) {
+	surface->format = format;
+	surface->dim = dim;
+	surface->stream = 0;
+	surface->file = NULL;
+	surface->gzfile = NULL;
+	surface->buffer = NULL;
+	surface->numberOfElements = 0;
+
+	// a named pipe or a socket at path is a consumer reading the surface while the hydro runs
+	struct stat st;
+	int fd = -1;
+	if(stat(path, &st) == 0 && (S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode))) {
+		surface->stream = 1;
+		// a consumer that goes away makes the next write fail instead of killing the process
+		signal(SIGPIPE, SIG_IGN);
+		if(S_ISSOCK(st.st_mode)) {
+			fd = connectFreezeoutSocket(path);
+		}
+		else {
+			printf("Waiting for a reader of the freezeout surface pipe %s\n", path);
+			fd = open(path, O_WRONLY);
+		}
+		if(fd < 0) {
+			printf("Could not connect to the freezeout surface stream %s!\n", path);
+			exit(-1);
+		}
+	}
+	size_t bufferSize = surface->stream ? FREEZEOUT_STREAM_BUFFER_SIZE : FREEZEOUT_FILE_BUFFER_SIZE;
+
+	if(format == FREEZEOUT_FORMAT_BINARY_GZIP) {
+		gzFile gz = surface->stream ? gzdopen(fd, "wb1") : gzopen(path, append ? "ab1" : "wb1");
+		if(gz) gzbuffer(gz, bufferSize);
+		surface->gzfile = (void *)gz;
+	}
+	else {
+		const char *mode = append ? "ab" : (format == FREEZEOUT_FORMAT_ASCII ? "w" : "wb");
+		surface->file = surface->stream ? fdopen(fd, mode) : fopen(path, mode);
+		if(surface->file) {
+			surface->buffer = (char *)malloc(bufferSize);
+			setvbuf(surface->file, surface->buffer, _IOFBF, bufferSize);
+		}
+	}
+	if(!surface->file && !surface->gzfile) {
+		printf("Could not open the freezeout surface file %s!\n", path);
+		exit(-1);
+	}
+	if(format == FREEZEOUT_FORMAT_ASCII || append) return;
+
+	int32_t header[6];
+	header[0] = FREEZEOUT_BINARY_VERSION;
+	header[1] = 0x01020304;
+	header[2] = dim;
+	header[3] = FREEZEOUT_SURFACE_COLUMNS;
+	header[4] = sizeof(float);
+	header[5] = strlen(freezeoutSurfaceSchema) + 1;
+	writeBytes(surface, FREEZEOUT_BINARY_MAGIC, 8);
+	writeBytes(surface, header, sizeof(header));
+	writeBytes(surface, freezeoutSurfaceSchema, header[5]);
+}
+
+void openFreezeoutSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface, const char *path, int format, int dim) {
+	openSurfaceFile(surface, path, format, dim, 0);
+}
+
+void resumeFreezeoutSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface, const char *path, int format, int dim, long offset,
+		long numberOfElements) {
+	struct stat st;
+	if(stat(path, &st) == 0 && (S_ISFIFO(st.st_mode) || S_ISSOCK(st.st_mode))) {
+		// a stream cannot be rewound: the consumer gets the elements found from the checkpoint on
+		openSurfaceFile(surface, path, format, dim, 0);
+	}
+	else {
+		if(stat(path, &st) != 0 || st.st_size < offset || truncate(path, offset) != 0) {
+			printf("The freezeout surface file %s does not have the %ld bytes it had at the checkpoint!\n", path, offset);
+			exit(-1);
+		}
+		openSurfaceFile(surface, path, format, dim, 1);
+	}
+	surface->numberOfElements = numberOfElements;
+}
+
+void encodeFreezeoutElement(const FREEZEOUT_SURFACE_FILE * const surface, const double * const element, std::string &buffer) {
+	if(surface->format == FREEZEOUT_FORMAT_ASCII) {
+		// same as writing the values with ostream << (6 significant digits)
+		char value[32];
+		for(int i = 0; i < FREEZEOUT_SURFACE_COLUMNS; ++i) {
+			int length = snprintf(value, sizeof(value), "%g", element[i]);
+			value[length++] = (i < FREEZEOUT_SURFACE_COLUMNS - 1) ? ' ' : '\n';
+			buffer.append(value, length);
+		}
+	}
+	else {
+		float record[FREEZEOUT_SURFACE_COLUMNS];
+		for(int i = 0; i < FREEZEOUT_SURFACE_COLUMNS; ++i) record[i] = (float)element[i];
+		buffer.append((const char *)record, sizeof(record));
+	}
+}
+
+void writeFreezeoutElements(FREEZEOUT_SURFACE_FILE * const surface, const char *bytes, size_t size, long numberOfElements) {
+	writeBytes(surface, bytes, size);
+	surface->numberOfElements += numberOfElements;
+}
+
+void flushFreezeoutSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface) {
+	if(!surface->stream) return;
+	int ok;
+	if(surface->gzfile) ok = gzflush((gzFile)surface->gzfile, Z_SYNC_FLUSH) == Z_OK;
+	else ok = fflush(surface->file) == 0;
+	if(!ok) {
+		printf("Error writing the freezeout surface file!\n");
+		exit(-1);
+	}
+}
+
+long freezeoutSurfaceFileOffset(FREEZEOUT_SURFACE_FILE * const surface) {
+	if(surface->stream) {
+		flushFreezeoutSurfaceFile(surface);
+		return 0;
+	}
+	long offset;
+	if(surface->gzfile) {
+		// the compressed stream is finished, and the elements after the offset are in a gzip member of their own,
+		// which can be appended to the file when the run is resumed
+		offset = gzflush((gzFile)surface->gzfile, Z_FINISH) == Z_OK ? (long)gzoffset((gzFile)surface->gzfile) : -1;
+	}
+	else {
+		offset = fflush(surface->file) == 0 ? ftell(surface->file) : -1;
+	}
+	if(offset < 0) {
+		printf("Error writing the freezeout surface file!\n");
+		exit(-1);
+	}
+	return offset;
+}
+
+void closeFreezeoutSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface) {
+	if(surface->gzfile) gzclose((gzFile)surface->gzfile);
+	if(surface->file) fclose(surface->file);
+	free(surface->buffer);
+	surface->file = NULL;
+	surface->gzfile = NULL;
+	surface->buffer = NULL;
+}
@@ -0,0 +1,79 @@
+/*
+ * FreezeoutSurfaceFile.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef FREEZEOUTSURFACEFILE_H_
+#define FREEZEOUTSURFACEFILE_H_
+
+#include <stdio.h>
+#include <string>
+
+// formats of the freezeout surface file (freezeoutFormat in output.properties)
+#define FREEZEOUT_FORMAT_ASCII 0 // iS3D ASCII layout, one element per line
+#define FREEZEOUT_FORMAT_BINARY 1 // versioned binary format, see below
+#define FREEZEOUT_FORMAT_BINARY_GZIP 2 // binary format compressed with zlib
+
+// every surface element has 26 columns:
+// tau x y eta, t*dsigma_mu (4), u^mu (4), e T P, pi^{mu nu} (10 upper triangle), Pi
+#define FREEZEOUT_SURFACE_COLUMNS 26
+
+// binary format: the header
+//	char[8]  magic "CPUVHFOS"
+//	int32    version
+//	int32    0x01020304, written in native byte order
+//	int32    dimension of the surface finder (4 for 3+1D, 3 for 2+1D)
+//	int32    number of columns
+//	int32    bytes per value (4, the values are single precision)
+//	int32    length of the schema string including its terminating zero
+//	char[]   schema: space separated "name[unit]" of the columns
+// is followed by the elements, one record of columns values each, until the end of the file
+#define FREEZEOUT_BINARY_MAGIC "CPUVHFOS"
+#define FREEZEOUT_BINARY_VERSION 1
+
+// streaming: if the path of the surface file is a named pipe (mkfifo) or a Unix domain socket on which a consumer
+// listens, the surface is written to it in the same format instead, while the hydro runs. The consumer sees the
+// elements of each search of the finder as soon as it is done. The writes block while the consumer lags behind, so
+// the finder (and the hydro, when it waits for the finder) runs at the pace of the consumer
+
+typedef struct
+{
+	int format;
+	int dim;
+	int stream; // writing to a pipe or a socket
+	FILE *file; // ASCII and binary
+	void *gzfile; // compressed binary
+	char *buffer; // stdio buffer of file
+	long numberOfElements;
+} FREEZEOUT_SURFACE_FILE;
+
+// path of the surface file of each format in directory: surface.dat, surface.bin or surface.bin.gz. When several
+// isotherms are extracted, their files are told apart by the temperature, e.g. surface_T155MeV.dat
+void freezeoutSurfaceFilePath(char *path, const char *directory, int format, int numberOfSurfaces, double temperatureGeV);
+
+void openFreezeoutSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface, const char *path, int format, int dim);
+
+// reopen the file of a checkpointed run (see HydroPlugin.cpp), which had numberOfElements elements in offset bytes
+// at the checkpoint: what was written after it is cut off and the elements are appended. A stream is opened anew
+void resumeFreezeoutSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface, const char *path, int format, int dim, long offset,
+		long numberOfElements);
+
+// append one element of FREEZEOUT_SURFACE_COLUMNS values to buffer, encoded in the format of the file;
+// can be called concurrently by several threads with their own buffers
+void encodeFreezeoutElement(const FREEZEOUT_SURFACE_FILE * const surface, const double * const element, std::string &buffer);
+
+// write numberOfElements encoded elements
+void writeFreezeoutElements(FREEZEOUT_SURFACE_FILE * const surface, const char *bytes, size_t size, long numberOfElements);
+
+// hand the elements written so far to the consumer of a stream; nothing for a regular file
+void flushFreezeoutSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface);
+
+// flush the elements written so far to the file and return its size, for a checkpoint. The compressed stream
+// of FREEZEOUT_FORMAT_BINARY_GZIP is finished, so that the file is a complete gzip file, to which the elements that
+// follow are written as another gzip member (gunzip and zlib read the members one after the other)
+long freezeoutSurfaceFileOffset(FREEZEOUT_SURFACE_FILE * const surface);
+
+void closeFreezeoutSurfaceFile(FREEZEOUT_SURFACE_FILE * const surface);
+
+#endif /* FREEZEOUTSURFACEFILE_H_ */
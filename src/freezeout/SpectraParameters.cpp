@@ -0,0 +1,70 @@
+/*
+ * SpectraParameters.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "../freezeout/SpectraParameters.h"
+#include "../util/Properties.h"
+
+int cooperFrye;
+int writeFreezeoutSurface;
+int shearCorrection;
+int numberOfHadrons;
+const char *hadrons[MAX_SPECTRA_HADRONS];
+int numberOfTransverseMomenta;
+double minTransverseMomentumGeV;
+double maxTransverseMomentumGeV;
+int numberOfAzimuthalAngles;
+int numberOfRapidities;
+double minRapidity;
+double maxRapidity;
+
+static const char * const defaultHadrons[] = {"pi+", "K+", "p"};
+
+void loadSpectraParameters(config_t *cfg, const char* configDirectory, void * params) {
+	// Read the file
+	char fname[255];
+	sprintf(fname, "%s/%s", configDirectory, "spectra.properties");
+	if (!config_read_file(cfg, fname)) {
+		fprintf(stderr, "No configuration file  %s found for spectra parameters - %s.\n", fname, config_error_text(cfg));
+		fprintf(stderr, "Using default spectra configuration parameters.\n");
+	}
+
+	getIntegerProperty(cfg, "cooperFrye", &cooperFrye, 0);
+	getIntegerProperty(cfg, "writeFreezeoutSurface", &writeFreezeoutSurface, 1);
+	getIntegerProperty(cfg, "shearCorrection", &shearCorrection, 1);
+	numberOfHadrons = getStringArrayProperty(cfg, "hadrons", hadrons, MAX_SPECTRA_HADRONS);
+	if(numberOfHadrons == 0) {
+		numberOfHadrons = sizeof(defaultHadrons) / sizeof(defaultHadrons[0]);
+		for(int i = 0; i < numberOfHadrons; ++i) hadrons[i] = defaultHadrons[i];
+	}
+	getIntegerProperty(cfg, "numberOfTransverseMomenta", &numberOfTransverseMomenta, 31);
+	getDoubleProperty(cfg, "minTransverseMomentumGeV", &minTransverseMomentumGeV, 0.0);
+	getDoubleProperty(cfg, "maxTransverseMomentumGeV", &maxTransverseMomentumGeV, 3.0);
+	getIntegerProperty(cfg, "numberOfAzimuthalAngles", &numberOfAzimuthalAngles, 32);
+	getIntegerProperty(cfg, "numberOfRapidities", &numberOfRapidities, 1);
+	getDoubleProperty(cfg, "minRapidity", &minRapidity, 0.0);
+	getDoubleProperty(cfg, "maxRapidity", &maxRapidity, 0.0);
+
+	struct SpectraParameters * spectra = (struct SpectraParameters *) params;
+	spectra->cooperFrye = cooperFrye;
+	spectra->writeFreezeoutSurface = writeFreezeoutSurface;
+	spectra->shearCorrection = shearCorrection;
+	spectra->numberOfHadrons = numberOfHadrons;
+	// the strings belong to cfg, which is destroyed after loading
+	for(int i = 0; i < numberOfHadrons; ++i) {
+		strncpy(spectra->hadrons[i], hadrons[i], MAX_HADRON_NAME_LENGTH - 1);
+		spectra->hadrons[i][MAX_HADRON_NAME_LENGTH - 1] = '\0';
+	}
+	spectra->numberOfTransverseMomenta = numberOfTransverseMomenta;
+	spectra->minTransverseMomentumGeV = minTransverseMomentumGeV;
+	spectra->maxTransverseMomentumGeV = maxTransverseMomentumGeV;
+	spectra->numberOfAzimuthalAngles = numberOfAzimuthalAngles;
+	spectra->numberOfRapidities = numberOfRapidities;
+	spectra->minRapidity = minRapidity;
+	spectra->maxRapidity = maxRapidity;
+}
@@ -0,0 +1,38 @@
+/*
+ * SpectraParameters.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef SPECTRAPARAMETERS_H_
+#define SPECTRAPARAMETERS_H_
+
+#include <libconfig.h>
+
+#define MAX_SPECTRA_HADRONS 32
+#define MAX_HADRON_NAME_LENGTH 16
+
+struct SpectraParameters
+{
+	// evaluate the Cooper-Frye spectra of the hadrons on the freezeout surface while it is found
+	int cooperFrye;
+	// write the freezeout surface file; can be turned off when only the spectra are needed
+	int writeFreezeoutSurface;
+	// include the 14-moment shear viscous correction \delta f
+	int shearCorrection;
+	// names of the hadrons, see the table in CooperFrye.cpp
+	int numberOfHadrons;
+	char hadrons[MAX_SPECTRA_HADRONS][MAX_HADRON_NAME_LENGTH];
+	// momentum grid: uniform in p_T, phi in [0, 2 pi) and y
+	int numberOfTransverseMomenta;
+	double minTransverseMomentumGeV;
+	double maxTransverseMomentumGeV;
+	int numberOfAzimuthalAngles;
+	int numberOfRapidities;
+	double minRapidity;
+	double maxRapidity;
+};
+
+void loadSpectraParameters(config_t *cfg, const char* configDirectory, void * params);
+
+#endif /* SPECTRAPARAMETERS_H_ */
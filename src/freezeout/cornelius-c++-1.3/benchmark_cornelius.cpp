@@ -0,0 +1,177 @@
+/**
+ *
+ * Microbenchmark for the 4d surface finder. Regenerates the random
+ * hypercubes of example_4d() in example_cornelius.cpp (same rand()
+ * sequence, after the 2d and 3d examples), checks the elements against
+ * the bundled output_4d.dat and then times find_surface_4d() over the
+ * same cubes. The random cubes are mostly ambiguous; the second set of
+ * cubes samples a smooth field, like the cells of a hydro surface. On
+ * both sets the lookup table is compared with the general algorithm and
+ * both are timed.
+ *
+ * usage: benchmark_cornelius [repeats]
+ *
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdlib.h>
+#include <math.h>
+#include <sys/time.h>
+#include "cornelius.h"
+
+using namespace std;
+
+static const int NCUBES = 10000;
+
+static double wallTime()
+{
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + 1e-6*tv.tv_usec;
+}
+
+static void fill(double ****cube, double *c)
+{
+  for (int i1=0; i1 < 2; i1++)
+    for (int i2=0; i2 < 2; i2++)
+      for (int i3=0; i3 < 2; i3++)
+        for (int i4=0; i4 < 2; i4++)
+          cube[i1][i2][i3][i4] = c[8*i1+4*i2+2*i3+i4];
+}
+
+//Compares the elements found with the lookup table to those of the general
+//algorithm and times find_surface_4d() with and without the table
+static void run(const char *name, double *corners, int repeats, double ****cube)
+{
+  double dx[4] = {1,1,1,1};
+  Cornelius table, general;
+  table.init(4,0.5,dx);
+  general.init(4,0.5,dx);
+  general.use_lookup_table(false);
+  int mismatches = 0;
+  int single = 0;
+  for (int iter=0; iter < NCUBES; iter++) {
+    fill(cube, corners + 16*iter);
+    table.find_surface_4d(cube);
+    general.find_surface_4d(cube);
+    single += general.get_Nelements() == 1;
+    if ( table.get_Nelements() != general.get_Nelements() ) {
+      mismatches++;
+      continue;
+    }
+    for (int i=0; i < general.get_Nelements(); i++)
+      for (int j=0; j < 4; j++)
+        if ( table.get_centroid_elem(i,j) != general.get_centroid_elem(i,j) ||
+             table.get_normal_elem(i,j) != general.get_normal_elem(i,j) )
+          mismatches++;
+  }
+  cout << name << ": " << single << " of " << NCUBES << " hypercubes with one element, "
+       << mismatches << " differences between the lookup table and the general algorithm" << endl;
+
+  Cornelius *cor[2] = {&general, &table};
+  for (int t=0; t < 2; t++) {
+    long Nelements = 0;
+    double start = wallTime();
+    for (int r=0; r < repeats; r++) {
+      for (int iter=0; iter < NCUBES; iter++) {
+        fill(cube, corners + 16*iter);
+        cor[t]->find_surface_4d(cube);
+        Nelements += cor[t]->get_Nelements();
+      }
+    }
+    double elapsed = wallTime() - start;
+    cout << "  " << (t ? "lookup table: " : "general:      ") << repeats*NCUBES << " hypercubes in " << elapsed
+         << " s: " << 1e9*elapsed/(repeats*NCUBES) << " ns/hypercube (" << Nelements << " elements)" << endl;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int repeats = argc > 1 ? atoi(argv[1]) : 20;
+
+  //Skip the random numbers consumed by example_2d() and example_3d()
+  for (int i=0; i < NCUBES*(4+8); i++)
+    rand();
+  double *corners = new double[NCUBES*16];
+  for (int i=0; i < NCUBES*16; i++)
+    corners[i] = rand()/double(RAND_MAX);
+
+  double ****cube = new double***[2];
+  for (int i1=0; i1 < 2; i1++) {
+    cube[i1] = new double**[2];
+    for (int i2=0; i2 < 2; i2++) {
+      cube[i1][i2] = new double*[2];
+      for (int i3=0; i3 < 2; i3++) {
+        cube[i1][i2][i3] = new double[2];
+      }
+    }
+  }
+  double dx[4] = {1,1,1,1};
+  Cornelius cor;
+  cor.init(4,0.5,dx);
+
+  //Check against the reference output
+  ostringstream output;
+  for (int iter=0; iter < NCUBES; iter++) {
+    fill(cube, corners + 16*iter);
+    cor.find_surface_4d(cube);
+    for (int i=0; i < cor.get_Nelements(); i++) {
+      for (int j=0; j < 4; j++)
+        output << cor.get_centroid_elem(i,j) << " ";
+      for (int j=0; j < 4; j++)
+        output << cor.get_normal_elem(i,j) << " ";
+      output << endl;
+    }
+  }
+  ifstream reference("output_4d.dat");
+  if ( reference.is_open() ) {
+    stringstream expected;
+    expected << reference.rdbuf();
+    cout << "output_4d.dat: " << (expected.str() == output.str() ? "match" : "MISMATCH") << endl;
+  } else {
+    cout << "output_4d.dat not found, skipping the check" << endl;
+  }
+
+  //Hypercubes of a smooth field: the corners of random cells of the lattice
+  //around a sphere where e(x) = 0.5
+  double *smooth = new double[NCUBES*16];
+  srand(1);
+  for (int iter=0; iter < NCUBES; iter++) {
+    double x0[4];
+    double r0 = 0;
+    for (int j=0; j < 4; j++) {
+      x0[j] = 2.0*rand()/double(RAND_MAX) - 1.0;
+      r0 += x0[j]*x0[j];
+    }
+    //move the cell onto the sphere of radius 10 lattice units
+    for (int j=0; j < 4; j++)
+      x0[j] = floor(10.0*x0[j]/sqrt(r0));
+    for (int c=0; c < 16; c++) {
+      double r2 = 0;
+      for (int j=0; j < 4; j++) {
+        double x = x0[j] + ((c >> (3-j)) & 1);
+        r2 += x*x;
+      }
+      smooth[16*iter + c] = exp(-r2/200.0)*0.5*exp(0.5);
+    }
+  }
+
+  run("random hypercubes", corners, repeats, cube);
+  run("smooth hypercubes", smooth, repeats, cube);
+
+  for (int i1=0; i1 < 2; i1++) {
+    for (int i2=0; i2 < 2; i2++) {
+      for (int i3=0; i3 < 2; i3++)
+        delete[] cube[i1][i2][i3];
+      delete[] cube[i1][i2];
+    }
+    delete[] cube[i1];
+  }
+  delete[] cube;
+  delete[] corners;
+  delete[] smooth;
+  return 0;
+}
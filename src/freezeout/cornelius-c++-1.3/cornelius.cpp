@@ -22,61 +22,28 @@
  *
  * Last update 03.08.2012 Hannu Holopainen
  *
- */
-
-#include <iostream>
-#include <fstream>
-#include <math.h>
-#include <stdlib.h>
-
-using namespace std;
-
-/**
+ * Modified 18.10.2026: compiled as its own translation unit against
+ * cornelius.h, and the temporary vectors of the element, cube and hypercube
+ * routines are fixed-size arrays instead of new/delete, so that finding the
+ * surface of a cell does no heap allocation.
  *
- * General class for elements. All other element classes are inherited
- * from this.
+ * Modified 18.10.2026: lookup table of the elements of every pattern of
+ * corners above and below the surface (class SurfaceTable), used for the
+ * cubes and hypercubes without squares with four cuts.
  *
  */
-class GeneralElement
-{
-  protected:
-    static const int DIM = 4;
-    double *centroid;
-    double *normal;
-    int normal_calculated;
-    int centroid_calculated;
-    virtual void calculate_centroid() {};
-    virtual void calculate_normal() {};
-    void check_normal_direction(double *normal, double *out);
-  public:
-    GeneralElement();
-    ~GeneralElement();
-    double *get_centroid();
-    double *get_normal();
-};
+
+#include "cornelius.h"
 
 /**
  *
- * Constructor allocates memory for centroid and normal. 
+ * Constructor. Centroid and normal are stored in the element itself.
  *
  */
 GeneralElement::GeneralElement()
 {
   normal_calculated = 0;
   centroid_calculated = 0;
-  centroid = new double[DIM];
-  normal = new double[DIM];
-}
-
-/**
- *
- * Destructor frees memory.
- *
- */
-GeneralElement::~GeneralElement()
-{
-  delete[] centroid;
-  delete[] normal;
 }
 
 /**
@@ -136,63 +103,12 @@ double *GeneralElement::get_normal()
 
 /**
  *
- * This class is used for line elements gotten from the squares. Can
- * calculate the centroid and normal of the line.
- *
- */
-class Line : public GeneralElement
-{
-  private:
-    static const int LINE_CORNERS = 2;
-    static const int LINE_DIM = 2;
-    int x1,x2;
-    int start_point;
-    int end_point;
-    double **corners;
-    double *out;
-    int *const_i;
-    void calculate_centroid();
-    void calculate_normal();
-  public:
-    Line();
-    ~Line();
-    void init(double**,double*,int*);
-    void flip_start_end();
-    double *get_start();
-    double *get_end();
-    double *get_out();
-};
-
-/**
- *
- * Constructor allocates memory for end points, point which is always
- * outside and indices of the elements which are constant.
+ * Constructor. End points, the point which is always outside and the
+ * indices of the elements which are constant are stored in the line itself.
  *
  */
 Line::Line()
 {
-  GeneralElement();
-  corners = new double*[LINE_CORNERS];
-  for (int i=0; i < LINE_CORNERS; i++) {
-    corners[i] = new double[DIM];
-  }
-  out = new double[DIM];
-  const_i = new int[DIM-LINE_DIM]; 
-}
-
-/**
- *
- * Frees memory allocated in constructor.
- *
- */
-Line::~Line()
-{
-  for (int i=0; i < LINE_CORNERS; i++) {
-    delete[] corners[i];
-  }
-  delete[] corners;
-  delete[] out;
-  delete[] const_i;
 }
 
 /**
@@ -281,12 +197,11 @@ void Line::calculate_normal()
   normal[const_i[0]] = 0;
   normal[const_i[1]] = 0;
   //Now we check if the normal is in the correct direction
-  double *Vout = new double[DIM];
+  double Vout[DIM];
   for (int j=0; j < DIM; j++) {
     Vout[j] = out[j] - centroid[j];
   }
   check_normal_direction(normal,Vout);
-  delete[] Vout;
   normal_calculated = 1;
 }
 
@@ -338,33 +253,6 @@ double *Line::get_out()
   return out;
 }
 
-/**
- *
- * A class for storing polygons given by Cornelius. Can calculate
- * the centroid and normal of the polygon.
- *
- */
-class Polygon : public GeneralElement
-{
-  private:
-    static const int MAX_LINES = 24;
-    static const int POLYGON_DIM = 3;
-    Line **lines;
-    int Nlines;
-    int x1,x2,x3;
-    int const_i;
-    void calculate_centroid();
-    void calculate_normal();
-  public:
-    Polygon();
-    ~Polygon();
-    void init(int);
-    bool add_line(Line*,int);
-    int get_Nlines();
-    Line** get_lines();
-    void print(ofstream &file,double*);
-};
-
 /**
  *
  * Allocates memory for the list of pointers to the lines which
@@ -373,7 +261,6 @@ class Polygon : public GeneralElement
  */
 Polygon::Polygon()
 {
-  GeneralElement();
   lines = new Line*[MAX_LINES];
 }
 
@@ -478,7 +365,7 @@ bool Polygon::add_line(Line *l, int donotcheck)
 void Polygon::calculate_centroid()
 {
   //We need a vector for the mean of the corners.
-  double *mean = new double[DIM];
+  double mean[DIM];
   for (int i=0; i < DIM; i++ ) {
     mean[i] = 0;
   }
@@ -501,22 +388,21 @@ void Polygon::calculate_centroid()
       centroid[i] = mean[i];
     }
     centroid_calculated = 1;
-    delete[] mean;
     return;
   }
   //If more than 3 corners, calculation of the centroid is more
   //complicated
   //Here we from triangles from the lines and the mean point
-  double *sum_up = new double[DIM]; //areas of the single triangles 
+  double sum_up[DIM]; //areas of the single triangles 
   double sum_down = 0; //area of all the triangles
   for (int i=0; i < DIM; i++) {
     sum_up[i] = 0;
   }
   //a and b are vectors which from the triangle
-  double *a = new double[DIM];
-  double *b = new double[DIM];
+  double a[DIM];
+  double b[DIM];
   //centroid of the triangle (this is always on a plane)
-  double *cm_i = new double[DIM];
+  double cm_i[DIM];
   for (int i=0; i < Nlines; i++) {
     double *p1 = lines[i]->get_start();
     double *p2 = lines[i]->get_end();
@@ -541,13 +427,8 @@ void Polygon::calculate_centroid()
   for (int i=0; i < DIM; i++) {
     centroid[i] = sum_up[i]/sum_down;
   }
-  //centroid is now calculated and memory is freed
+  //centroid is now calculated
   centroid_calculated = 1;
-  delete[] sum_up;
-  delete[] mean;
-  delete[] a;
-  delete[] b;
-  delete[] cm_i;
 }
 
 /**
@@ -562,18 +443,16 @@ void Polygon::calculate_normal()
   if ( !centroid_calculated )
     calculate_centroid();
   //First we find the normal for each triangle formed from
-  //one edge and centroid
-  double **normals = new double*[Nlines]; //these are the normals
-  double *Vout = new double[DIM]; //the point which is always outside
-  for (int i=0; i < Nlines; i++) {
-    normals[i] = new double[DIM];
-    for (int j=0; j < DIM; j++) {
-      normals[i][j] = 0;
-    }
+  //one edge and centroid. The normal of the polygon is the sum of
+  //these, accumulated in the same order as the triangles.
+  double normal_i[DIM]; //normal of the triangle
+  double Vout[DIM]; //the point which is always outside
+  for (int i=0; i < DIM; i++) {
+    normal[i] = 0;
   }
   //Normal is defined by these two vectors
-  double *a = new double[DIM];
-  double *b = new double[DIM];
+  double a[DIM];
+  double b[DIM];
   //Loop over all triangles
   for (int i=0; i < Nlines; i++) {
     //First we calculate the vectors which form the triangle
@@ -584,36 +463,23 @@ void Polygon::calculate_normal()
       b[j] = p2[j] - centroid[j];
     }
     //Normal is calculated as a cross product of these vectors
-    normals[i][x1] =  0.5*(a[x2]*b[x3]-a[x3]*b[x2]);
-    normals[i][x2] = -0.5*(a[x1]*b[x3]-a[x3]*b[x1]);
-    normals[i][x3] =  0.5*(a[x1]*b[x2]-a[x2]*b[x1]);
-    normals[i][const_i] = 0;
+    normal_i[x1] =  0.5*(a[x2]*b[x3]-a[x3]*b[x2]);
+    normal_i[x2] = -0.5*(a[x1]*b[x3]-a[x3]*b[x1]);
+    normal_i[x3] =  0.5*(a[x1]*b[x2]-a[x2]*b[x1]);
+    normal_i[const_i] = 0;
     //Then we construct a vector which points out
     double *o = lines[i]->get_out();
     for (int j=0; j < DIM; j++) {
       Vout[j] = o[j] - centroid[j];
     }
     //then we check that normal is point in the correct direction
-    check_normal_direction(normals[i],Vout);
-  }
-  //Finally the normal is a sum of the normals of the triangles
-  for (int i=0; i < DIM; i++) {
-    normal[i] = 0;
-  }
-  for (int i=0; i < Nlines; i++) {
+    check_normal_direction(normal_i,Vout);
+    //Finally the normal is a sum of the normals of the triangles
     for (int j=0; j < DIM; j++) {
-      normal[j] += normals[i][j];
+      normal[j] += normal_i[j];
     }
   }
-  //Normal is now calculated and memory can be freed
   normal_calculated = 1;
-  delete[] a;
-  delete[] b;
-  for (int i=0; i < Nlines; i++) {
-    delete[] normals[i];
-  }
-  delete[] normals;
-  delete[] Vout;
 }
 
 /**
@@ -660,31 +526,6 @@ void Polygon::print(ofstream &file, double *pos)
   }
 }
 
-/**
- *
- * A class for storing polyhedrons given by Cornelius. Can calculate
- * the normal and centroid of the polyhedron.
- *
- */
-class Polyhedron : public GeneralElement
-{
-  private:
-    static const int MAX_POLYGONS = 24;
-    Polygon **polygons;
-    int Npolygons;
-    int Ntetrahedra;
-    int x1,x2,x3,x4;
-    bool lines_equal(Line*,Line*);
-    void tetravolume(double*,double*,double*,double*);
-    void calculate_centroid();
-    void calculate_normal();
-  public:
-    Polyhedron();
-    ~Polyhedron();
-    void init();
-    bool add_polygon(Polygon*,int);
-};
-
 /**
  * 
  * Allocates memory for a list pointers to the polygons which form
@@ -693,7 +534,6 @@ class Polyhedron : public GeneralElement
  */
 Polyhedron::Polyhedron()
 {
-  GeneralElement();
   polygons = new Polygon*[MAX_POLYGONS];
 }
 
@@ -841,7 +681,7 @@ void Polyhedron::tetravolume(double *a, double *b, double *c, double *n)
  */
 void Polyhedron::calculate_centroid()
 {
-  double *mean = new double[DIM];
+  double mean[DIM];
   for (int i=0; i < DIM; i++ ) {
     mean[i] = 0;
   }
@@ -860,13 +700,13 @@ void Polyhedron::calculate_centroid()
   for (int j=0; j < DIM; j++ ) {
     mean[j] = mean[j]/double(2.0*Ntetrahedra);
   }
-  //Some memory allocated for temporary variables
-  double *a = new double[DIM];
-  double *b = new double[DIM];
-  double *c = new double[DIM];
-  double *n = new double[DIM];
-  double *cm_i = new double[DIM];
-  double *sum_up = new double[DIM];
+  //Temporary variables
+  double a[DIM];
+  double b[DIM];
+  double c[DIM];
+  double n[DIM];
+  double cm_i[DIM];
+  double sum_up[DIM];
   double sum_down = 0;
   for (int i=0; i < DIM; i++) {
     sum_up[i] = 0;
@@ -908,15 +748,8 @@ void Polyhedron::calculate_centroid()
   for (int i=0; i < DIM; i++) {
     centroid[i] = sum_up[i]/sum_down;
   }
-  //Centroid is now calculated and we can free memory
+  //Centroid is now calculated
   centroid_calculated = 1;
-  delete[] a;
-  delete[] b;
-  delete[] c;
-  delete[] n;
-  delete[] cm_i;
-  delete[] sum_up;
-  delete[] mean;
 }
 
 /**
@@ -931,16 +764,16 @@ void Polyhedron::calculate_normal()
   //need to check that it is calculated
   if ( !centroid_calculated )
     calculate_centroid();
-  //First we allocate memory for temporary variables
-  double *Vout = new double[DIM];
-  double *a = new double[DIM];
-  double *b = new double[DIM];
-  double *c = new double[DIM];
-  double **normals = new double*[Ntetrahedra];
-  for (int i=0; i < Ntetrahedra; i++) {
-    normals[i] = new double[DIM];
+  //Temporary variables. The element normal is the sum of the normals
+  //of the tetrahedra, accumulated in the same order as the tetrahedra.
+  double Vout[DIM];
+  double a[DIM];
+  double b[DIM];
+  double c[DIM];
+  double normal_i[DIM];
+  for (int i=0; i < DIM; i++) {
+    normal[i] = 0;
   }
-  int Ntetra = 0; //Index of tetrahedron we are dealing with
   for (int i=0; i < Npolygons; i++ ) {
     int Nlines = polygons[i]->get_Nlines();
     Line **lines = polygons[i]->get_lines();
@@ -955,75 +788,22 @@ void Polyhedron::calculate_normal()
         c[k] = cent[k] - centroid[k];
       }
       //Normal is calculated with the same function as volume
-      tetravolume(a,b,c,normals[Ntetra]);
+      tetravolume(a,b,c,normal_i);
       //Then we determine the direction towards lower energy
       double *o = lines[j]->get_out();
       for (int k=0; k < DIM; k++) {
         Vout[k] = o[k] - centroid[k];
       }
-      check_normal_direction(normals[Ntetra],Vout);
-      Ntetra++;
-    }
-  }
-  //Finally the element normal is a sum of the calculated normals
-  for (int i=0; i < DIM; i++) {
-    normal[i] = 0;
-  }
-  for (int i=0; i < Ntetrahedra; i++) {
-    for (int j=0; j < DIM; j++) {
-      normal[j] += normals[i][j];
+      check_normal_direction(normal_i,Vout);
+      //Finally the element normal is a sum of the calculated normals
+      for (int k=0; k < DIM; k++) {
+        normal[k] += normal_i[k];
+      }
     }
   }
-  //Normal is now determined and we can free memory
+  //Normal is now determined
   normal_calculated = 1;
-  for (int i=0; i < Ntetrahedra; i++) {
-    delete[] normals[i];
-  }
-  delete[] a;
-  delete[] b;
-  delete[] c;
-  delete[] normals;
-  delete[] Vout;
-}
-
-/**
- *
- * This class handles the squares. Finds the edges of the surface and also
- * the points which are always outside the surface so that we can determine
- * correct direction for normal vector.
- *
- */
-class Square
-{
-  private:
-    static const int DIM = 4;
-    static const int SQUARE_DIM = 2;
-    static const int MAX_POINTS = 4;
-    static const int MAX_LINES = 2;
-    double **points;
-    double **cuts;
-    double **out;
-    double **points_temp;
-    double *out_temp;
-    int *const_i;
-    double *const_value;
-    int x1, x2;
-    double *dx;
-    int Ncuts;
-    int Nlines;
-    Line *lines;
-    int ambiguous;
-    void ends_of_edge(double);
-    void find_outside(double);
-  public:
-    Square();
-    ~Square();
-    void init(double**,int*,double*,double*);
-    void construct_lines(double);
-    int is_ambiguous();
-    int get_Nlines();
-    Line* get_lines();
-};
+}
 
 /**
  *
@@ -1373,44 +1153,6 @@ Line* Square::get_lines()
 }
 
 
-/**
- *
- * This class handles 3d-cubes. Splits them into squares and collects
- * polygons from the lines given from squares.
- *
- */
-class Cube
-{
-  private:
-    static const int DIM = 4;
-    static const int CUBE_DIM = 4;
-    static const int MAX_POLY = 8;
-    static const int NSQUARES = 6;
-    static const int STEPS = 2;
-    double ***cube;
-    Line **lines;
-    Polygon *polygons;
-    Square *squares;
-    int Nlines;
-    int Npolygons;
-    int ambiguous;
-    int const_i;
-    double const_value;
-    int x1,x2,x3;
-    double *dx;
-    void split_to_squares();
-    void check_ambiguous(int);
-  public:
-    Cube();
-    ~Cube();
-    void init(double***&,int,double,double*&);
-    void construct_polygons(double);
-    int get_Nlines();
-    int get_Npolygons();
-    int is_ambiguous();
-    Polygon* get_polygons();
-};
-
 /**
  *
  * Constructor allocated memory.
@@ -1501,12 +1243,10 @@ void Cube::init(double ***&c, int c_i, double c_v, double *&dex)
  */
 void Cube::split_to_squares()
 {
-  double **sq = new double*[STEPS];
-  int *c_i = new int[STEPS];
-  double *c_v = new double[STEPS];
-  for (int i=0; i < STEPS; i++) {
-    sq[i] = new double[STEPS]; 
-  }
+  double sq_values[STEPS][STEPS];
+  double *sq[STEPS] = {sq_values[0], sq_values[1]};
+  int c_i[STEPS];
+  double c_v[STEPS];
   int Nsquares = 0;
   for (int i=0; i < DIM; i++) {
     //i is the index which is kept constant, thus we ignore the index which
@@ -1533,12 +1273,6 @@ void Cube::split_to_squares()
       }
     }
   }
-  for (int i=0; i < STEPS; i++) {
-    delete[] sq[i];
-  }
-  delete[] sq; 
-  delete[] c_i;
-  delete[] c_v;
 }
 
 /**
@@ -1579,7 +1313,7 @@ void Cube::construct_polygons(double value0)
   if ( ambiguous > 0 ) {
     //Surface is ambiguous, so let's connect the lines to polygons and see how
     //many polygons we have
-    int *not_used = new int[Nlines];
+    int not_used[NSQUARES*2]; //each square may have max. 2 lines
     for (int i=0; i < Nlines; i++) {
       not_used[i] = 1;
     }
@@ -1608,7 +1342,6 @@ void Cube::construct_polygons(double value0)
       //When we have reached this point one complete polygon is formed
       Npolygons++;
     } while ( used < Nlines );
-    delete[] not_used;
   } else {
     //Surface is not ambiguous, so we have only one polygons and all lines
     //can be added to it without ordering them
@@ -1690,38 +1423,6 @@ Polygon* Cube::get_polygons()
   return polygons;
 }
 
-/**
- *
- * This class handles 4d-cubes. Splits them into cubes and collects the
- * polygons from the cubes and form polyhedrons from these. 
- *
- */
-class Hypercube
-{
-  private:
-    static const int DIM = 4;
-    static const int MAX_POLY = 10;
-    static const int NCUBES = 8;
-    static const int STEPS = 2;
-    double ****hcube;
-    Polyhedron *polyhedrons;
-    Polygon **polygons;
-    Cube *cubes;
-    int Npolyhedrons;
-    int ambiguous;
-    int x1,x2,x3,x4;
-    double *dx;
-    void split_to_cubes();
-    void check_ambiguous(double);
-  public:
-    Hypercube();
-    ~Hypercube();
-    void init(double****,double*);
-    void construct_polyhedrons(double);
-    int get_Npolyhedrons();
-    Polyhedron* get_polyhedrons();
-};
-
 /**
  *
  * Constructor allocates memory.
@@ -1805,13 +1506,11 @@ void Hypercube::init(double ****c, double *dex)
  */
 void Hypercube::split_to_cubes()
 {
-  double ***cu = new double**[STEPS];
-  for (int i=0; i < STEPS; i++) {
-    cu[i] = new double*[STEPS]; 
-    for (int j=0; j < STEPS; j++) {
-      cu[i][j] = new double[STEPS]; 
-    }
-  }
+  double cu_values[STEPS][STEPS][STEPS];
+  double *cu_rows[STEPS][STEPS] = {{cu_values[0][0], cu_values[0][1]},
+                                   {cu_values[1][0], cu_values[1][1]}};
+  double **cu_planes[STEPS] = {cu_rows[0], cu_rows[1]};
+  double ***cu = cu_planes;
   int Ncubes = 0;
   for (int i=0; i < DIM; i++) {
     //i is the index which is kept constant, thus we ignore the index which
@@ -1838,13 +1537,6 @@ void Hypercube::split_to_cubes()
       Ncubes++;
     }
   }
-  for (int i=0; i < STEPS; i++) {
-    for (int j=0; j < STEPS; j++) {
-      delete[] cu[i][j];
-    }
-    delete[] cu[i];
-  }
-  delete[] cu;
 }
 
 /**
@@ -1875,7 +1567,7 @@ void Hypercube::construct_polyhedrons(double value0)
   if ( ambiguous > 0 ) {
     //Here surface might be ambiguous and we need to connect the polygons and
     //see how many polyhedrons we have
-    int *not_used = new int[Npolygons];
+    int not_used[NCUBES*10]; //same bound as the polygons table
     for (int i=0; i < Npolygons; i++) {
       not_used[i] = 1;
     }
@@ -1900,7 +1592,6 @@ void Hypercube::construct_polyhedrons(double value0)
       //When we have reached this point one complete polyhedron is formed
       Npolyhedrons++;
     } while ( used < Npolygons );
-    delete[] not_used;
     /*if ( ambiguous == 0 && Npolyhedrons != 1 ) {
       cout << "error" << endl;
     }*/
@@ -1988,50 +1679,742 @@ Polyhedron* Hypercube::get_polyhedrons()
 
 /**
  *
- * A class for finding a constant value surface from a 2-4 dimensional
- * cube. The values at corners and length of the side are needed as
- * an input.
- *
- * Algorithm by Pasi Huovinen. This code is based on the original FORTRAN
- * code by Pasi Huovinen.
- *
- */
-class Cornelius
-{
-  private:
-    static const int STEPS = 2;
-    static const int DIM = 4;
-    static const int MAX_ELEMENTS = 10;
-    int Nelements;
-    double **normals;
-    double **centroids;
-    int cube_dim;
-    int initialized;
-    int print_initialized;
-    double value0;
-    double *dx;
-    ofstream output_print;
-    void surface_3d(double***,double*,int);
-    Square cu2d;
-    Cube cu3d;
-    Hypercube cu4d;
-  public:
-    Cornelius();
-    ~Cornelius();
-    void init(int,double,double*);
-    void init_print(string);
-    void find_surface_2d(double**);
-    void find_surface_3d(double***);
-    void find_surface_3d_print(double***,double*);
-    void find_surface_4d(double****);
-    int get_Nelements();
-    double **get_normals();
-    double **get_centroids();
-    double **get_normals_4d();
-    double **get_centroids_4d();
-    double get_centroid_elem(int,int);
-    double get_normal_elem(int,int);
-};
+ * Constructor builds the table for all patterns of the corners of a cube
+ * (d=3) or a hypercube (d=4). Bit i of a pattern is set if the value at
+ * corner i=8*i1+4*i2+2*i3+i4 is above or at the surface value.
+ *
+ * @param [in] d Dimension of the problem, 3 or 4
+ *
+ */
+SurfaceTable::SurfaceTable(int d)
+{
+  cube_dim = d;
+  int Npatterns = 1 << (1 << cube_dim);
+  pattern_index = new int[Npatterns];
+  //Only the patterns which are not ambiguous are stored. The entries and
+  //the lines are first counted and then stored.
+  Pattern entry;
+  TableLine buffer[MAX_LINES];
+  int Nentries = 0;
+  int Nlines_total = 0;
+  patterns = NULL;
+  lines = NULL;
+  for (int pass=0; pass < 2; pass++) {
+    Nentries = 0;
+    Nlines_total = 0;
+    for (int pattern=0; pattern < Npatterns; pattern++) {
+      int Nlines = build_pattern(pattern,entry,buffer);
+      if ( Nlines < 0 ) {
+        pattern_index[pattern] = -1;
+        continue;
+      }
+      entry.first_line = Nlines_total;
+      if ( pass == 1 ) {
+        patterns[Nentries] = entry;
+        for (int i=0; i < Nlines; i++) {
+          lines[Nlines_total+i] = buffer[i];
+        }
+      }
+      pattern_index[pattern] = Nentries;
+      Nentries++;
+      Nlines_total += Nlines;
+    }
+    if ( pass == 0 ) {
+      patterns = new Pattern[Nentries];
+      lines = new TableLine[Nlines_total];
+    }
+  }
+}
+
+/**
+ *
+ * Destructor frees the table.
+ *
+ */
+SurfaceTable::~SurfaceTable()
+{
+  delete[] pattern_index;
+  delete[] patterns;
+  delete[] lines;
+}
+
+/**
+ *
+ * Finds the lines of a cube in the same order as Cube::construct_polygons,
+ * i.e. the squares of Cube::split_to_squares and the cuts of
+ * Square::ends_of_edge.
+ *
+ * @param [in]  pattern     Pattern of the corners above the surface
+ * @param [in]  const_i     Index which is constant in this cube
+ * @param [in]  const_value Value of the constant index, 0 or 1
+ * @param [out] l           Lines of the cube
+ *
+ * @return Number of the lines, -1 if a square has four cuts
+ *
+ */
+int SurfaceTable::cube_lines(int pattern, int const_i, int const_value, TableLine *l)
+{
+  int Nlines = 0;
+  for (int i=0; i < DIM; i++) {
+    if ( i == const_i )
+      continue;
+    int x1 = -1;
+    int x2 = -1;
+    for (int k=0; k < DIM; k++) {
+      if ( k != const_i && k != i ) {
+        if ( x1 < 0 ) {
+          x1 = k;
+        } else {
+          x2 = k;
+        }
+      }
+    }
+    for (int j=0; j < 2; j++) {
+      int b[DIM];
+      b[const_i] = const_value;
+      b[i] = j;
+      int corner[2][2];
+      int above = 0;
+      for (int ci1=0; ci1 < 2; ci1++) {
+        for (int ci2=0; ci2 < 2; ci2++) {
+          b[x1] = ci1;
+          b[x2] = ci2;
+          corner[ci1][ci2] = 8*b[0]+4*b[1]+2*b[2]+b[3];
+          above += (pattern >> corner[ci1][ci2]) & 1;
+        }
+      }
+      if ( above == 0 || above == 4 )
+        continue;
+      //The edges in the order of Square::ends_of_edge
+      int start[4] = {corner[0][0], corner[0][0], corner[1][0], corner[0][1]};
+      int end[4] = {corner[1][0], corner[0][1], corner[1][1], corner[1][1]};
+      int axis[4] = {x1, x2, x2, x1};
+      int edge[4];
+      int Ncuts = 0;
+      for (int e=0; e < 4; e++) {
+        if ( ((pattern >> start[e]) ^ (pattern >> end[e])) & 1 ) {
+          edge[Ncuts] = 16*axis[e] + start[e];
+          Ncuts++;
+        }
+      }
+      if ( Ncuts == 4 )
+        return -1;
+      TableLine &line = l[Nlines];
+      line.edge[0] = edge[0];
+      line.edge[1] = edge[1];
+      //The outside point of Square::find_outside
+      for (int k=0; k < DIM; k++) {
+        line.out[k] = 0;
+      }
+      line.out[const_i] = const_value;
+      line.out[i] = j;
+      line.Nout = 0;
+      for (int ci1=0; ci1 < 2; ci1++) {
+        for (int ci2=0; ci2 < 2; ci2++) {
+          if ( !((pattern >> corner[ci1][ci2]) & 1) ) {
+            line.out[x1] += ci1;
+            line.out[x2] += ci2;
+            line.Nout++;
+          }
+        }
+      }
+      line.free = (1 << x1) | (1 << x2);
+      Nlines++;
+    }
+  }
+  return Nlines;
+}
+
+/**
+ *
+ * Connects the lines of an ambiguous cube to polygons as
+ * Cube::construct_polygons and Polygon::add_line do, two end points being
+ * the same if they are on the same edge.
+ *
+ * @param [in/out] l              Lines of the cube, flipped as in add_line
+ * @param [in]     Nlines         Number of the lines
+ * @param [out]    polygon_Nlines Number of the lines of each polygon
+ * @param [out]    order          Lines of the polygons one after another
+ *
+ * @return Number of the polygons, -1 if the lines cannot be connected
+ *
+ */
+int SurfaceTable::cube_polygons(TableLine *l, int Nlines, int *polygon_Nlines, int *order)
+{
+  int not_used[CUBE_LINES];
+  for (int i=0; i < Nlines; i++) {
+    not_used[i] = 1;
+  }
+  int used = 0;
+  int Npolygons = 0;
+  do {
+    if ( Nlines - used < 3 )
+      return -1;
+    int count = 0;
+    for (int i=0; i < Nlines; i++) {
+      if ( !not_used[i] )
+        continue;
+      int added = count == 0;
+      if ( !added ) {
+        int last = l[order[used-1]].edge[1];
+        if ( l[i].edge[0] == last ) {
+          added = 1;
+        } else if ( l[i].edge[1] == last ) {
+          l[i].edge[1] = l[i].edge[0];
+          l[i].edge[0] = last;
+          added = 1;
+        }
+      }
+      if ( added ) {
+        order[used] = i;
+        not_used[i] = 0;
+        used++;
+        count++;
+        i = 0;
+      }
+    }
+    polygon_Nlines[Npolygons] = count;
+    Npolygons++;
+  } while ( used < Nlines );
+  return Npolygons;
+}
+
+/**
+ *
+ * Finds the elements of a pattern as Cornelius::surface_3d and
+ * Hypercube::construct_polyhedrons do.
+ *
+ * @param [in]  pattern Pattern of the corners above the surface
+ * @param [out] p       Entry of the pattern
+ * @param [out] l       Lines of the polygons of the elements one after another
+ *
+ * @return Number of the lines, -1 if a square has four cuts or the general
+ *         algorithm cannot connect the lines
+ *
+ */
+int SurfaceTable::build_pattern(int pattern, Pattern &p, TableLine *l)
+{
+  int connected = 0;
+  //The polygons of all cubes in the order of Hypercube::split_to_cubes
+  TableLine polygon_lines[MAX_POLYGONS][CUBE_LINES];
+  int polygon_Nlines[MAX_POLYGONS];
+  int polygon_const_i[MAX_POLYGONS];
+  int Npolygons = 0;
+  int Nlines_total = 0;
+  int Ncubes = cube_dim == 3 ? 1 : 2*DIM;
+  for (int n=0; n < Ncubes; n++) {
+    int const_i = cube_dim == 3 ? 0 : n/2;
+    int const_value = cube_dim == 3 ? 0 : n%2;
+    TableLine cube[CUBE_LINES];
+    int Nlines = cube_lines(pattern,const_i,const_value,cube);
+    if ( Nlines < 0 ) {
+      return -1;
+    }
+    Nlines_total += Nlines;
+    int order[CUBE_LINES];
+    int Nlines_poly[CUBE_LINES];
+    int Npoly = 0;
+    //As in Cube::check_ambiguous, with six lines the lines are connected
+    if ( Nlines == 6 ) {
+      connected = 1;
+      Npoly = cube_polygons(cube,Nlines,Nlines_poly,order);
+      if ( Npoly < 0 ) {
+        return -1;
+      }
+    } else if ( Nlines > 0 ) {
+      Npoly = 1;
+      Nlines_poly[0] = Nlines;
+      for (int i=0; i < Nlines; i++) {
+        order[i] = i;
+      }
+    }
+    int k = 0;
+    for (int i=0; i < Npoly; i++) {
+      if ( Npolygons == MAX_POLYGONS ) {
+        return -1;
+      }
+      polygon_const_i[Npolygons] = const_i;
+      polygon_Nlines[Npolygons] = Nlines_poly[i];
+      for (int j=0; j < Nlines_poly[i]; j++) {
+        polygon_lines[Npolygons][j] = cube[order[k]];
+        k++;
+      }
+      Npolygons++;
+    }
+  }
+  if ( Npolygons == 0 ) {
+    p.connected = 0;
+    p.Nelements = 0;
+    p.Npolygons = 0;
+    return 0;
+  }
+  //The polygons of each element one after another
+  int polygon_order[MAX_POLYGONS];
+  int element_Npolygons[MAX_POLYGONS];
+  int Nelements = 0;
+  if ( cube_dim == 4 && !connected ) {
+    //As in Hypercube::check_ambiguous
+    int points = 0;
+    for (int c=0; c < 16; c++) {
+      if ( !((pattern >> c) & 1) )
+        points++;
+    }
+    if ( points > 8 )
+      points = 16-points;
+    if ( Nlines_total == 24 && points == 2 )
+      connected = 1;
+  }
+  if ( cube_dim == 3 ) {
+    //Every polygon is an element
+    for (int i=0; i < Npolygons; i++) {
+      polygon_order[i] = i;
+      element_Npolygons[i] = 1;
+    }
+    Nelements = Npolygons;
+  } else if ( connected ) {
+    //Polyhedron::add_polygon connects the polygons which have a common point
+    int not_used[MAX_POLYGONS];
+    for (int i=0; i < Npolygons; i++) {
+      not_used[i] = 1;
+    }
+    int used = 0;
+    do {
+      int first = used;
+      for (int i=0; i < Npolygons; i++) {
+        if ( !not_used[i] )
+          continue;
+        int added = used == first;
+        for (int q=first; q < used && !added; q++) {
+          int m = polygon_order[q];
+          for (int j=0; j < polygon_Nlines[i] && !added; j++) {
+            for (int k=0; k < polygon_Nlines[m] && !added; k++) {
+              int start = polygon_lines[m][k].edge[0];
+              if ( polygon_lines[i][j].edge[0] == start || polygon_lines[i][j].edge[1] == start )
+                added = 1;
+            }
+          }
+        }
+        if ( added ) {
+          polygon_order[used] = i;
+          not_used[i] = 0;
+          used++;
+          i = 0;
+        }
+      }
+      element_Npolygons[Nelements] = used - first;
+      Nelements++;
+    } while ( used < Npolygons );
+  } else {
+    //A single polyhedron
+    for (int i=0; i < Npolygons; i++) {
+      polygon_order[i] = i;
+    }
+    element_Npolygons[0] = Npolygons;
+    Nelements = 1;
+  }
+  if ( Nelements > MAX_ELEMENTS )
+    return -1;
+  p.connected = connected;
+  p.Nelements = Nelements;
+  for (int i=0; i < Nelements; i++) {
+    p.element_Npolygons[i] = element_Npolygons[i];
+  }
+  int Nlines = 0;
+  for (int i=0; i < Npolygons; i++) {
+    int m = polygon_order[i];
+    p.polygon_const_i[i] = polygon_const_i[m];
+    p.polygon_Nlines[i] = polygon_Nlines[m];
+    for (int j=0; j < polygon_Nlines[m]; j++) {
+      l[Nlines] = polygon_lines[m][j];
+      Nlines++;
+    }
+  }
+  p.Npolygons = Npolygons;
+  return Nlines;
+}
+
+/**
+ *
+ * Returns the entry of a pattern.
+ *
+ * @param [in] p Pattern of the corners above the surface
+ *
+ * @return Entry of the pattern, NULL if the pattern is ambiguous
+ *
+ */
+const SurfaceTable::Pattern* SurfaceTable::get_pattern(int p)
+{
+  if ( pattern_index[p] < 0 )
+    return NULL;
+  return &patterns[pattern_index[p]];
+}
+
+/**
+ *
+ * Returns the lines of all patterns. The lines of a pattern start at
+ * Pattern::first_line.
+ *
+ * @return Lines of all patterns
+ *
+ */
+const SurfaceTable::TableLine* SurfaceTable::get_lines()
+{
+  return lines;
+}
+
+/**
+ *
+ * The tables are shared by all instances of Cornelius and built when they
+ * are first needed.
+ *
+ */
+static SurfaceTable& surface_table(int cube_dim)
+{
+  static SurfaceTable table_3d(3);
+  if ( cube_dim == 3 )
+    return table_3d;
+  static SurfaceTable table_4d(4);
+  return table_4d;
+}
+
+/**
+ *
+ * Centroid of the polygon formed by the given lines, with the same arithmetic
+ * as Polygon::calculate_centroid.
+ *
+ */
+static void table_polygon_centroid(double (*points)[4], const SurfaceTable::TableLine *l,
+                                   int Nlines, int const_i, double *centroid)
+{
+  const int DIM = 4;
+  int x[3];
+  int n = 0;
+  for (int i=0; i < DIM; i++) {
+    if ( i != const_i ) {
+      x[n] = i;
+      n++;
+    }
+  }
+  int x1 = x[0];
+  int x2 = x[1];
+  int x3 = x[2];
+  double mean[DIM];
+  for (int i=0; i < DIM; i++) {
+    mean[i] = 0;
+  }
+  for (int i=0; i < Nlines; i++) {
+    double *p1 = points[l[i].edge[0]];
+    double *p2 = points[l[i].edge[1]];
+    for (int j=0; j < DIM; j++) {
+      mean[j] += p1[j] + p2[j];
+    }
+  }
+  for (int j=0; j < DIM; j++) {
+    mean[j] = mean[j]/double(2.0*Nlines);
+  }
+  if ( Nlines == 3 ) {
+    for (int i=0; i < DIM; i++) {
+      centroid[i] = mean[i];
+    }
+    return;
+  }
+  double sum_up[DIM];
+  double sum_down = 0;
+  for (int i=0; i < DIM; i++) {
+    sum_up[i] = 0;
+  }
+  double a[DIM];
+  double b[DIM];
+  double cm_i[DIM];
+  for (int i=0; i < Nlines; i++) {
+    double *p1 = points[l[i].edge[0]];
+    double *p2 = points[l[i].edge[1]];
+    for (int j=0; j < DIM; j++) {
+      cm_i[j] = (p1[j] + p2[j] + mean[j])/3.0;
+    }
+    for (int j=0; j < DIM; j++) {
+      a[j] = p1[j] - mean[j];
+      b[j] = p2[j] - mean[j];
+    }
+    double A_i = 0.5*sqrt( pow(a[x2]*b[x3]-a[x3]*b[x2],2.0) + pow(a[x1]*b[x3]-a[x3]*b[x1],2.0) + pow(a[x2]*b[x1]-a[x1]*b[x2],2.0) );
+    for (int j=0; j < DIM; j++) {
+      sum_up[j] += cm_i[j]*A_i;
+    }
+    sum_down += A_i;
+  }
+  for (int i=0; i < DIM; i++) {
+    centroid[i] = sum_up[i]/sum_down;
+  }
+}
+
+/**
+ *
+ * Point which is outside the surface for a line of the table, the same
+ * point as Square::find_outside gives.
+ *
+ */
+static void table_outside_point(const SurfaceTable::TableLine &l, double *dx, double *out)
+{
+  for (int i=0; i < 4; i++) {
+    out[i] = l.out[i]*dx[i];
+    if ( (l.free >> i) & 1 )
+      out[i] = out[i]/double(l.Nout);
+  }
+}
+
+/**
+ *
+ * Turns the normal to the outward direction, as
+ * GeneralElement::check_normal_direction.
+ *
+ */
+static void table_check_normal_direction(double *normal, double *out)
+{
+  double dot_product = 0;
+  for (int i=0; i < 4; i++) {
+    dot_product += out[i]*normal[i];
+  }
+  if ( dot_product < 0 ) {
+    for (int i=0; i < 4; i++) {
+      normal[i] = -normal[i];
+    }
+  }
+}
+
+/**
+ *
+ * Tells if a square of the cube has four cuts, i.e. if the pattern is not in
+ * the lookup table. This is a few bit operations, so the cubes that go to
+ * the general algorithm do no extra work for the table.
+ *
+ * @param [in] pattern  Pattern of the corners above the surface
+ * @param [in] cube_dim Dimension of the cube, 3 or 4
+ *
+ * @return True if a square has four cuts
+ *
+ */
+static bool has_four_cut_square(int pattern, int cube_dim)
+{
+  const int DIM = 4;
+  //The corners without index i, i.e. where the edges in the direction of i start
+  static const int edge_start[DIM] = {0x00FF, 0x0F0F, 0x3333, 0x5555};
+  //Bit c of cut[i] tells if the edge from corner c in the direction of i is cut
+  int cut[DIM];
+  for (int i=DIM-cube_dim; i < DIM; i++) {
+    cut[i] = (pattern ^ (pattern >> (8 >> i))) & edge_start[i];
+  }
+  for (int i=DIM-cube_dim; i < DIM; i++) {
+    for (int j=i+1; j < DIM; j++) {
+      //All four edges of the square from corner c in the directions i and j
+      if ( cut[i] & (cut[i] >> (8 >> j)) & cut[j] & (cut[j] >> (8 >> i)) & edge_start[j] )
+        return true;
+    }
+  }
+  return false;
+}
+
+/**
+ *
+ * Fast path of find_surface_3d and find_surface_4d. The elements are taken
+ * from the table of the pattern of the corners, so the cube is not split to
+ * cubes and squares, and the crossing point on every edge is calculated
+ * once. The centroids and normals are calculated with the same arithmetic
+ * as in Polygon and Polyhedron, so the results are the same as those of the
+ * general algorithm.
+ *
+ * @param [in] v       Values at the corners 8*i1+4*i2+2*i3+i4, i1 = 0 in 3d
+ * @param [in] pattern Pattern of the corners above the surface
+ * @param [in] cuts    Crossing points of the edges in units of the length
+ *                     of the side, or NULL if they are calculated here (see
+ *                     find_surface_4d)
+ *
+ * @return False if the surface is ambiguous and the general algorithm
+ *         must be used
+ *
+ */
+bool Cornelius::surface_from_table(const double *v, int pattern, const double *cuts)
+{
+  SurfaceTable &table = surface_table(cube_dim);
+  int Ncorners = 1 << cube_dim;
+  const SurfaceTable::Pattern *entry = table.get_pattern(pattern);
+  if ( entry == NULL )
+    return false;
+  const SurfaceTable::Pattern &p = *entry;
+  //The points where the surface crosses the edges, as in Square::ends_of_edge
+  double points[16*DIM][DIM];
+  for (int k=DIM-cube_dim; k < DIM; k++) {
+    int bit = 8 >> k;
+    for (int c=0; c < Ncorners; c++) {
+      if ( (c & bit) || !(((pattern >> c) ^ (pattern >> (c | bit))) & 1) )
+        continue;
+      double *point = points[16*k + c];
+      double v1 = v[c];
+      double v2 = v[c | bit];
+      if ( cuts != NULL ) {
+        //NaN if the edge has no cut
+        if ( !(cuts[16*k + c] == cuts[16*k + c]) )
+          return false;
+        point[k] = cuts[16*k + c]*dx[k];
+      } else if ( (v1-value0)*(v2-value0) < 0 ) {
+        point[k] = (v1-value0)/(v1-v2)*dx[k];
+      } else if ( v1 == value0 && v2 < value0 ) {
+        point[k] = 1e-9*dx[k];
+      } else if ( v2 == value0 && v1 < value0 ) {
+        point[k] = (1.0-1e-9)*dx[k];
+      } else {
+        return false;
+      }
+      //When the lines are connected, the general algorithm takes end points
+      //closer than 1e-10 to be the same
+      if ( p.connected && (point[k] < 1e-10 || dx[k]-point[k] < 1e-10) )
+        return false;
+      for (int i=0; i < DIM; i++) {
+        if ( i != k )
+          point[i] = (c & (8 >> i)) ? dx[i] : 0;
+      }
+    }
+  }
+  const SurfaceTable::TableLine *l = table.get_lines() + p.first_line;
+  double Vout[DIM];
+  double out[DIM];
+  double a[DIM];
+  double b[DIM];
+  double c[DIM];
+  double normal_i[DIM];
+  if ( cube_dim == 3 ) {
+    //Polygon::calculate_centroid and Polygon::calculate_normal
+    for (int e=0; e < p.Nelements; e++) {
+      int Nlines = p.polygon_Nlines[e];
+      double *centroid = centroids[e];
+      double *normal = normals[e];
+      table_polygon_centroid(points,l,Nlines,0,centroid);
+      for (int i=0; i < DIM; i++) {
+        normal[i] = 0;
+      }
+      for (int i=0; i < Nlines; i++) {
+        double *p1 = points[l[i].edge[0]];
+        double *p2 = points[l[i].edge[1]];
+        for (int j=0; j < DIM; j++) {
+          a[j] = p1[j] - centroid[j];
+          b[j] = p2[j] - centroid[j];
+        }
+        normal_i[1] =  0.5*(a[2]*b[3]-a[3]*b[2]);
+        normal_i[2] = -0.5*(a[1]*b[3]-a[3]*b[1]);
+        normal_i[3] =  0.5*(a[1]*b[2]-a[2]*b[1]);
+        normal_i[0] = 0;
+        table_outside_point(l[i],dx,out);
+        for (int j=0; j < DIM; j++) {
+          Vout[j] = out[j] - centroid[j];
+        }
+        table_check_normal_direction(normal_i,Vout);
+        for (int j=0; j < DIM; j++) {
+          normal[j] += normal_i[j];
+        }
+      }
+      l += Nlines;
+    }
+    Nelements = p.Nelements;
+    return true;
+  }
+  int polygon = 0;
+  for (int e=0; e < p.Nelements; e++) {
+    int Npolygons = p.element_Npolygons[e];
+    double *centroid = centroids[e];
+    double *normal = normals[e];
+    //Polyhedron::calculate_centroid
+    double mean[DIM];
+    for (int i=0; i < DIM; i++) {
+      mean[i] = 0;
+    }
+    int Ntetrahedra = 0;
+    const SurfaceTable::TableLine *lp = l;
+    for (int i=0; i < Npolygons; i++) {
+      int Nlines = p.polygon_Nlines[polygon+i];
+      for (int j=0; j < Nlines; j++) {
+        double *p1 = points[lp[j].edge[0]];
+        double *p2 = points[lp[j].edge[1]];
+        for (int k=0; k < DIM; k++) {
+          mean[k] += p1[k] + p2[k];
+        }
+      }
+      lp += Nlines;
+      Ntetrahedra += Nlines;
+    }
+    for (int j=0; j < DIM; j++) {
+      mean[j] = mean[j]/double(2.0*Ntetrahedra);
+    }
+    double cent[SurfaceTable::MAX_POLYGONS][DIM];
+    double cm_i[DIM];
+    double n[DIM];
+    double sum_up[DIM];
+    double sum_down = 0;
+    for (int i=0; i < DIM; i++) {
+      sum_up[i] = 0;
+    }
+    lp = l;
+    for (int i=0; i < Npolygons; i++) {
+      int Nlines = p.polygon_Nlines[polygon+i];
+      table_polygon_centroid(points,lp,Nlines,p.polygon_const_i[polygon+i],cent[i]);
+      for (int j=0; j < Nlines; j++) {
+        double *p1 = points[lp[j].edge[0]];
+        double *p2 = points[lp[j].edge[1]];
+        for (int k=0; k < DIM; k++) {
+          cm_i[k] = (p1[k] + p2[k] + cent[i][k] + mean[k])/4.0;
+        }
+        for (int k=0; k < DIM; k++) {
+          a[k] = p1[k] - mean[k];
+          b[k] = p2[k] - mean[k];
+          c[k] = cent[i][k] - mean[k];
+        }
+        Polyhedron::tetravolume(a,b,c,n);
+        double V_i = 0;
+        for (int k=0; k < DIM; k++) {
+          V_i += n[k]*n[k];
+        }
+        V_i = sqrt(V_i);
+        for (int k=0; k < DIM; k++) {
+          sum_up[k] += cm_i[k]*V_i;
+        }
+        sum_down += V_i;
+      }
+      lp += Nlines;
+    }
+    for (int i=0; i < DIM; i++) {
+      centroid[i] = sum_up[i]/sum_down;
+    }
+    //Polyhedron::calculate_normal
+    for (int i=0; i < DIM; i++) {
+      normal[i] = 0;
+    }
+    lp = l;
+    for (int i=0; i < Npolygons; i++) {
+      int Nlines = p.polygon_Nlines[polygon+i];
+      for (int j=0; j < Nlines; j++) {
+        double *p1 = points[lp[j].edge[0]];
+        double *p2 = points[lp[j].edge[1]];
+        for (int k=0; k < DIM; k++) {
+          a[k] = p1[k] - centroid[k];
+          b[k] = p2[k] - centroid[k];
+          c[k] = cent[i][k] - centroid[k];
+        }
+        Polyhedron::tetravolume(a,b,c,normal_i);
+        table_outside_point(lp[j],dx,out);
+        for (int k=0; k < DIM; k++) {
+          Vout[k] = out[k] - centroid[k];
+        }
+        table_check_normal_direction(normal_i,Vout);
+        for (int k=0; k < DIM; k++) {
+          normal[k] += normal_i[k];
+        }
+      }
+      lp += Nlines;
+    }
+    l = lp;
+    polygon += Npolygons;
+  }
+  Nelements = p.Nelements;
+  return true;
+}
 
 /**
  *
@@ -2043,6 +2426,7 @@ Cornelius::Cornelius()
   Nelements = 0;
   initialized = 0;
   print_initialized = 0;
+  use_table = 1;
   normals = new double*[MAX_ELEMENTS];
   centroids = new double*[MAX_ELEMENTS];
   for (int i=0; i < MAX_ELEMENTS; i++) {
@@ -2116,6 +2500,20 @@ void Cornelius::init_print(string filename)
   print_initialized = 1;
 }
 
+/**
+ *
+ * Switches the lookup table of the non-ambiguous cubes and hypercubes on
+ * (default) or off. When it is off, all surface elements are found with the
+ * general algorithm.
+ *
+ * @param [in] use True if the lookup table is used
+ *
+ */
+void Cornelius::use_lookup_table(bool use)
+{
+  use_table = use;
+}
+
 /**
  *
  * Finds the surface elements in 2-dimensional case.
@@ -2130,8 +2528,8 @@ void Cornelius::find_surface_2d(double **cube)
     cout << "Cornelius not initialized for 2D case" << endl;
     exit(1);
   }
-  int *c_i = new int[cube_dim];
-  double *c_v = new double[cube_dim];
+  int c_i[2];
+  double c_v[2];
   c_i[0] = 0;
   c_i[1] = 1;
   c_v[0] = 0;
@@ -2146,8 +2544,6 @@ void Cornelius::find_surface_2d(double **cube)
       centroids[i][j] = l[i].get_centroid()[j];
     }
   }
-  delete[] c_i;
-  delete[] c_v;
 }
 
 /**
@@ -2161,7 +2557,25 @@ void Cornelius::find_surface_2d(double **cube)
 void Cornelius::find_surface_3d(double ***cube)
 {
   double *pos = NULL;
-  surface_3d(cube,pos,0);
+  surface_3d(cube,pos,0,NULL);
+}
+
+/**
+ *
+ * Finds the surface elements in 3-dimensional case, with the crossing points
+ * of the edges given (see find_surface_4d).
+ *
+ * @param [in] cube Values at the corners of the cube as a 3d table so that value
+ *                  [0][0][0] is at (0,0,0) and [1][1][1] is at (dx1,dx2,dx3).
+ * @param [in] cuts Crossing points of the edges, cuts[16*i+j] is on the edge
+ *                  from corner j=4*i1+2*i2+i3 in the direction of index i
+ *                  (1-3).
+ *
+ */
+void Cornelius::find_surface_3d(double ***cube, const double *cuts)
+{
+  double *pos = NULL;
+  surface_3d(cube,pos,0,cuts);
 }
 
 /**
@@ -2176,7 +2590,7 @@ void Cornelius::find_surface_3d(double ***cube)
  */
 void Cornelius::find_surface_3d_print(double ***cube, double *pos)
 {
-  surface_3d(cube,pos,1);
+  surface_3d(cube,pos,1,NULL);
 }
 
 /**
@@ -2187,9 +2601,10 @@ void Cornelius::find_surface_3d_print(double ***cube, double *pos)
  *                      [0][0][0] is at (0,0,0) and [1][1][1] is at (dx1,dx2,dx3).
  * @param [in] pos      Absolute position at the point [0][0][0] in form (0,x1,x2,x3).
  * @param [in] do_print 1 if triangles are printed, otherwise 0
+ * @param [in] cuts     Crossing points of the edges or NULL
  *
  */
-void Cornelius::surface_3d(double ***cube, double *pos, int do_print)
+void Cornelius::surface_3d(double ***cube, double *pos, int do_print, const double *cuts)
 {
   if ( !initialized || cube_dim != 3 ) {
     cout << "Cornelius not initialized for 3D case" << endl;
@@ -2198,13 +2613,15 @@ void Cornelius::surface_3d(double ***cube, double *pos, int do_print)
   //First we check if the cube actually contains surface elements.
   //If all or none of the elements are below the criterion, no surface
   //elements exist.
+  //The pattern of the corners above the surface is kept for the lookup table
+  double v[8];
+  int pattern = 0;
   int above = 0;
-  for (int i=0; i < STEPS; i++) {
-    for (int j=0; j < STEPS; j++) { 
-      for (int k=0; k < STEPS; k++) {
-        if ( cube[i][j][k] >= value0 )
-          above++;
-      }
+  for (int c=0; c < 8; c++) {
+    v[c] = cube[c/4][(c/2)%2][c%2];
+    if ( v[c] >= value0 ) {
+      pattern |= 1 << c;
+      above++;
     }
   }
   if ( above == 0 || above == 8 ) {
@@ -2212,6 +2629,11 @@ void Cornelius::surface_3d(double ***cube, double *pos, int do_print)
     Nelements = 0;
     return;
   }
+  //Cubes which cannot be ambiguous are found from the lookup table
+  if ( use_table && !do_print && !has_four_cut_square(pattern,3) ) {
+    if ( surface_from_table(v,pattern,cuts) )
+      return;
+  }
   //This cube has surface elements, so let's start by constructing
   //the cube.
   int c_i = 0;
@@ -2246,6 +2668,30 @@ void Cornelius::surface_3d(double ***cube, double *pos, int do_print)
  *
  */
 void Cornelius::find_surface_4d(double ****cube)
+{
+  find_surface_4d(cube,NULL);
+}
+
+/**
+ *
+ * Finds the surface elements in 4-dimensional case, with the crossing points
+ * of the edges given. When the cubes share edges, as the cells of a lattice
+ * do, the crossing points can be calculated once for all of them. They are
+ * used by the lookup table; the general algorithm calculates its own.
+ *
+ * @param [in] cube Values at the corners of the cube as a 4d table so that value
+ *                  [0][0][0][0] is at (0,0,0,0) and [1][1][1][1] is at
+ *                  (dx1,dx2,dx3,dx4).
+ * @param [in] cuts Crossing points of the edges, cuts[16*i+j] is on the edge
+ *                  from corner j=8*i1+4*i2+2*i3+i4 in the direction of index
+ *                  i, in units of dx_i, as Square::ends_of_edge finds them:
+ *                  (v_j-v0)/(v_j-v_j'), 1e-9 or 1-1e-9 when one end is at
+ *                  the surface value, and NaN if the edge has no cut. Only
+ *                  the edges from the corners with i_i = 0 are used. NULL if
+ *                  they are calculated here.
+ *
+ */
+void Cornelius::find_surface_4d(double ****cube, const double *cuts)
 {
   if ( !initialized || cube_dim != 4 ) {
     cout << "Cornelius not initialized for 4D case" << endl;
@@ -2254,15 +2700,15 @@ void Cornelius::find_surface_4d(double ****cube)
   //First we check if the cube actually contains surface elements.
   //If all or none of the elements are below the criterion, no surface
   //elements exist.
+  //The pattern of the corners above the surface is kept for the lookup table
+  double v[16];
+  int pattern = 0;
   int above = 0;
-  for (int i=0; i < STEPS; i++) {
-    for (int j=0; j < STEPS; j++) { 
-      for (int k=0; k < STEPS; k++) {
-        for (int l=0; l < STEPS; l++) {
-          if ( cube[i][j][k][l] >= value0 )
-            above++;
-        }
-      }
+  for (int c=0; c < 16; c++) {
+    v[c] = cube[c/8][(c/4)%2][(c/2)%2][c%2];
+    if ( v[c] >= value0 ) {
+      pattern |= 1 << c;
+      above++;
     }
   }
   if ( above == 0 || above == 16 ) {
@@ -2270,6 +2716,11 @@ void Cornelius::find_surface_4d(double ****cube)
     Nelements = 0;
     return;
   }
+  //Hypercubes which cannot be ambiguous are found from the lookup table
+  if ( use_table && !has_four_cut_square(pattern,4) ) {
+    if ( surface_from_table(v,pattern,cuts) )
+      return;
+  }
   //This cube has surface elements, so let's start by constructing
   //the hypercube.
   cu4d.init(cube,dx);
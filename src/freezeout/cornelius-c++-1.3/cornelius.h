@@ -18,8 +18,8 @@ class GeneralElement
 {
   protected:
     static const int DIM = 4;
-    double *centroid;
-    double *normal;
+    double centroid[DIM];
+    double normal[DIM];
     int normal_calculated;
     int centroid_calculated;
     virtual void calculate_centroid() {};
@@ -27,7 +27,6 @@ class GeneralElement
     void check_normal_direction(double *normal, double *out);
   public:
     GeneralElement();
-    ~GeneralElement();
     double *get_centroid();
     double *get_normal();
 };
@@ -46,14 +45,13 @@ class Line : public GeneralElement
     int x1,x2;
     int start_point;
     int end_point;
-    double **corners;
-    double *out;
-    int *const_i;
+    double corners[LINE_CORNERS][DIM];
+    double out[DIM];
+    int const_i[DIM-LINE_DIM];
     void calculate_centroid();
     void calculate_normal();
   public:
     Line();
-    ~Line();
     void init(double**,double*,int*);
     void flip_start_end();
     double *get_start();
@@ -103,10 +101,10 @@ class Polyhedron : public GeneralElement
     int Ntetrahedra;
     int x1,x2,x3,x4;
     bool lines_equal(Line*,Line*);
-    void tetravolume(double*,double*,double*,double*);
     void calculate_centroid();
     void calculate_normal();
   public:
+    static void tetravolume(double*,double*,double*,double*);
     Polyhedron();
     ~Polyhedron();
     void init();
@@ -229,6 +227,63 @@ class Hypercube
     Polyhedron* get_polyhedrons();
 };
 
+/**
+ *
+ * Lookup table for the fast path of Cornelius. For a given pattern of
+ * corners above and below the surface value, the lines which Cube and
+ * Hypercube find from the squares and the way they connect them to polygons
+ * and polyhedrons depend only on the pattern, as long as no square has four
+ * cuts. This table stores for every pattern of a 3d cube or a 4d hypercube
+ * the surface elements, their polygons and the lines of the polygons in the
+ * order in which the general algorithm finds them: the edges of the end
+ * points and the point which is outside the surface.
+ *
+ * 18.10.2026
+ *
+ */
+class SurfaceTable
+{
+  public:
+    static const int DIM = 4;
+    static const int MAX_ELEMENTS = 10;
+    static const int MAX_POLYGONS = 16;
+    //A line of a polygon, from edge[0] to edge[1]. The edges are numbered
+    //axis*16 + corner, where corner = 8*i1+4*i2+2*i3+i4 is the end of the
+    //edge with the smaller coordinate. The outside point is out[i]*dx[i],
+    //divided by Nout for the axes of the square (bit i of free set).
+    struct TableLine {
+      unsigned char edge[2];
+      unsigned char out[DIM];
+      unsigned char Nout;
+      unsigned char free;
+    };
+    //connected: the lines or polygons were connected by comparing their
+    //end points, which holds only if no two cuts are at the same point.
+    struct Pattern {
+      int first_line;
+      unsigned char connected;
+      unsigned char Nelements;
+      unsigned char Npolygons;
+      unsigned char element_Npolygons[MAX_ELEMENTS];
+      unsigned char polygon_const_i[MAX_POLYGONS];
+      unsigned char polygon_Nlines[MAX_POLYGONS];
+    };
+    SurfaceTable(int);
+    ~SurfaceTable();
+    const Pattern* get_pattern(int);
+    const TableLine* get_lines();
+  private:
+    static const int CUBE_LINES = 12;
+    static const int MAX_LINES = 8*CUBE_LINES;
+    int cube_dim;
+    int *pattern_index;
+    Pattern *patterns;
+    TableLine *lines;
+    int cube_lines(int,int,int,TableLine*);
+    int cube_polygons(TableLine*,int,int*,int*);
+    int build_pattern(int,Pattern&,TableLine*);
+};
+
 /**
  *
  * A class for finding a constant value surface from a 2-4 dimensional
@@ -256,7 +311,9 @@ class Cornelius
     double value0;
     double *dx;
     ofstream output_print;
-    void surface_3d(double***,double*,int);
+    void surface_3d(double***,double*,int,const double*);
+    int use_table;
+    bool surface_from_table(const double*,int,const double*);
     Square cu2d;
     Cube cu3d;
     Hypercube cu4d;
@@ -265,10 +322,13 @@ class Cornelius
     ~Cornelius();
     void init(int,double,double*);
     void init_print(string);
+    void use_lookup_table(bool);
     void find_surface_2d(double**);
     void find_surface_3d(double***);
+    void find_surface_3d(double***,const double*);
     void find_surface_3d_print(double***,double*);
     void find_surface_4d(double****);
+    void find_surface_4d(double****,const double*);
     int get_Nelements();
     double **get_normals();
     double **get_centroids();
@@ -1,7 +1,7 @@
 /**
  *
  * Simple program which demostrates how one should use cornelius++
- * from cornelius.cpp. Makes squares, cubes and hypercubes
+ * from cornelius.h. Makes squares, cubes and hypercubes
  * with random corner values from 0-1 and finds the surface elements
  * for the value 0.5 and writes them into files.
  *
@@ -11,7 +11,7 @@
 
 #include <iostream>
 #include <fstream>
-#include "cornelius.cpp"
+#include "cornelius.h"
 
 using namespace std;
 
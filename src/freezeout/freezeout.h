@@ -1,191 +1,1254 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <omp.h>
+#include <pthread.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+
 #include "../hydro/DynamicalVariables.h"
+#include "../eos/EquationOfState.h"
+#include "../freezeout/cornelius-c++-1.3/cornelius.h"
+#include "../freezeout/FreezeoutSurfaceFile.h"
+#include "../freezeout/CooperFrye.h"
 
-//return a 4 dimensional linear interpolation inside the hypercube, given the values
-//on the corners (a0000 through a1111) and edge lengths x0 through x3
-double linearInterp4D(double x0, double x1, double x2, double x3,
-                      double a0000, double a1000, double a0100, double a0010, double a0001,
-                      double a1100, double a1010, double a1001,
-                      double a0110, double a0101, double a0011,
-                      double a1110, double a1101, double a0111, double a1011, double a1111)
-{
-  double result = 0;
-  result = ((1-x0) * (1-x1) * (1-x2) * (1-x3) * a0000)
-            + ((x0) * (1-x1) * (1-x2) * (1-x3) * a1000)
-            + ((1-x0) * (x1) * (1-x2) * (1-x3) * a0100)
-            + ((1-x0) * (1-x1) * (x2) * (1-x3) * a0010)
-            + ((1-x0) * (1-x1) * (1-x2) * (x3) * a0001)
-            + ((x0) * (x1) * (1-x2) * (1-x3) * a1100)
-            + ((x0) * (1-x1) * (x2) * (1-x3) * a1010)
-            + ((x0) * (1-x1) * (1-x2) * (x3) * a1001)
-            + ((1-x0) * (x1) * (x2) * (1-x3) * a0110)
-            + ((1-x0) * (x1) * (1-x2) * (x3) * a0101)
-            + ((1-x0) * (1-x1) * (x2) * (x3) * a0011)
-            + ((x0) * (x1) * (x2) * (1-x3) * a1110)
-            + ((x0) * (x1) * (1-x2) * (x3) * a1101)
-            + ((x0) * (1-x1) * (x2) * (x3) * a1011)
-            + ((1-x0) * (x1) * (x2) * (x3) * a0111)
-            + ((x0) * (x1) * (x2) * (x3) * a1111);
-
-  return result;
-}
-
-double linearInterp3D(double x0, double x1, double x2,
-                      double a000, double a100, double a010, double a001,
-                      double a110, double a101, double a011, double a111)
-{
-  double result = 0;
-  result = ((1-x0) * (1-x1) * (1-x2) * a000)
-            + ((x0) * (1-x1) * (1-x2) * a100)
-            + ((1-x0) * (x1) * (1-x2) * a010)
-            + ((1-x0) * (1-x1) * (x2) * a001)
-            + ((x0) * (x1) * (1-x2) * a110)
-            + ((x0) * (1-x1) * (x2) * a101)
-            + ((1-x0) * (x1) * (x2) * a011)
-            + ((x0) * (x1) * (x2)  * a111);
-
-  return result;
-}
-
-void swapAndSetHydroVariables(double ****energy_density_evoution, double *****hydrodynamic_evoution,
-                              CONSERVED_VARIABLES * const __restrict__ q, PRECISION * const __restrict__ e,
-                              FLUID_VELOCITY * const __restrict__ u, int nx, int ny, int nz, int FOFREQ)
+//uses the array allocators in memory.h
+
+//number of hydrodynamic variables stored for each cell in the freezeout history:
+//u0, u1, u2, u3, e, pi00, pi01, pi02, pi03, pi11, pi12, pi13, pi22, pi23, pi33, Pi
+#define NUMBER_FREEZEOUT_VARIABLES 16
+#define FREEZEOUT_ENERGY_DENSITY 4
+
+//time history of the hydrodynamic variables searched by the freezeout finder.
+//the time slices form a ring : time step n is stored in slot (n+1) % nslots, so the slice shared by
+//two consecutive calls to the finder stays in place. The energy density is stored for all cells, with ix fastest;
+//all the variables only for the cells near the freezeout surfaces, where the finder needs them. Which cells these
+//are is decided when a step is stored: the hypercubes between it and the previous step that cross an isotherm are
+//known exactly, and those that may cross before the next step are predicted by extrapolating the energy density
+//of their corners; the corners of both, and of the cubes within FREEZEOUT_CAPTURE_MARGIN of them, are stored.
+//When a cube crosses without having been predicted, the variables of its corners at the previous step are stored
+//late, with the step: the hydro still holds them (see setHydroVariables)
+typedef struct
+{
+  int nslots;
+  int nx, ny, nz;
+  size_t ncells;
+  int dim;
+  //the spatial axes of the lattice with more than one point (0, 1, 2 for x, y, z), which span the hypercubes with
+  //the time axis: dim = 1 + the number of them
+  int axes[3];
+  //the distance between neighbouring cells along x, y, z; 0 along a degenerate axis
+  size_t strides[3];
+  int nsurfaces;
+  const double *freezeoutEnergyDensities;
+  double *energy; //energy density of slot k at energy + k * ncells
+  //bit k of the crossing mask of a cell in slot k is set if its hypercube between this and the next time step
+  //crosses isotherm k. The mask of a slot is written when the next step is stored
+  unsigned char *crossing;
+  //the variables of cell c in slot k are at records[k][recordIndex[k * ncells + c] * NUMBER_FREEZEOUT_VARIABLES],
+  //the index is -1 if they are not stored
+  int *recordIndex;
+  std::vector<double> *records;
+  //the cells whose variables at the previous step were stored late in slot k, in increasing order, and their
+  //variables at lateRecords[k][i * NUMBER_FREEZEOUT_VARIABLES]
+  std::vector<size_t> *lateCells;
+  std::vector<double> *lateRecords;
+  int lastStep; //the last step stored
+  //min and max of the energy density over the corners of the cube of each cell, at the last two steps
+  double *cubeMin, *cubeMax;
+  unsigned char *capture, *dilated; //cubes whose corners are stored
+  std::vector<size_t> rowStart;
+  long capturedCells, capturedSteps;
+  long lateStoredCells; //cells whose variables were stored a step late
+  long foundElements, keptElements; //surface elements found by cornelius, and left after coalescing
+} FREEZEOUT_HISTORY;
+
+//the variables of the corners of the cubes within this many cells of a crossing or predicted cube are stored
+#define FREEZEOUT_CAPTURE_MARGIN 1
+//a cube may cross before the next step if the energy density range of its corners, widened by this many times
+//their largest change since the previous step, contains the freezeout energy density
+#define FREEZEOUT_CAPTURE_EXTRAPOLATION 2.0
+
+//the spatial axes with more than one lattice point; returns their number
+int freezeoutSpatialAxes(int nx, int ny, int nz, int * const axes)
+{
+  int n[3] = {nx, ny, nz};
+  int naxes = 0;
+  for (int axis = 0; axis < 3; axis++)
+    if (n[axis] > 1) axes[naxes++] = axis;
+  return naxes;
+}
+
+void * allocateFreezeoutArray(size_t bytes)
 {
-  #pragma omp parallel for collapse(3)
-  for (int ix = 2; ix < nx+2; ix++)
+  void *data;
+  if (posix_memalign(&data, 64, bytes) != 0)
   {
-    for (int iy = 2; iy < ny+2; iy++)
-    {
-      for (int iz = 2; iz < nz+2; iz++)
-      {
-        int s = columnMajorLinearIndex(ix, iy, iz, nx+4, ny+4);
-        //previous hydro variable values written to zeroth index
-        energy_density_evoution[0][ix-2][iy-2][iz-2] = energy_density_evoution[FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[0][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[0][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[1][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[1][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[2][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[2][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[3][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[3][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[4][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[4][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[5][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[5][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[6][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[6][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[7][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[7][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[8][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[8][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[9][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[9][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[10][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[10][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[11][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[11][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[12][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[12][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[13][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[13][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[14][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[14][FOFREQ][ix-2][iy-2][iz-2];
-        hydrodynamic_evoution[15][0][ix-2][iy-2][iz-2] = hydrodynamic_evoution[15][FOFREQ][ix-2][iy-2][iz-2];
-
-        //current hydro variable values written to first index
-        energy_density_evoution[1][ix-2][iy-2][iz-2] = (double)e[s];
-        hydrodynamic_evoution[0][1][ix-2][iy-2][iz-2] = (double)(u->ut[s]);
-        hydrodynamic_evoution[1][1][ix-2][iy-2][iz-2] = (double)(u->ux[s]);
-        hydrodynamic_evoution[2][1][ix-2][iy-2][iz-2] = (double)(u->uy[s]);
-        hydrodynamic_evoution[3][1][ix-2][iy-2][iz-2] = (double)(u->un[s]);
-        hydrodynamic_evoution[4][1][ix-2][iy-2][iz-2] = (double)(e[s]);
+    printf("Could not allocate memory for the freezeout history!\n");
+    exit(-1);
+  }
+  memset(data, 0, bytes);
+  return data;
+}
+
+void allocateFreezeoutHistory(FREEZEOUT_HISTORY * const history, int nslots, int nx, int ny, int nz, int dim,
+                              int nsurfaces, const double * const freezeoutEnergyDensities)
+{
+  history->nslots = nslots;
+  history->nx = nx;
+  history->ny = ny;
+  history->nz = nz;
+  history->ncells = (size_t)nx * ny * nz;
+  history->dim = dim;
+  freezeoutSpatialAxes(nx, ny, nz, history->axes);
+  history->strides[0] = nx > 1 ? 1 : 0;
+  history->strides[1] = ny > 1 ? (size_t)nx : 0;
+  history->strides[2] = nz > 1 ? (size_t)nx * ny : 0;
+  history->nsurfaces = nsurfaces;
+  history->freezeoutEnergyDensities = freezeoutEnergyDensities;
+  history->energy = (double *)allocateFreezeoutArray(nslots * history->ncells * sizeof(double));
+  history->crossing = (unsigned char *)allocateFreezeoutArray(nslots * history->ncells);
+  history->recordIndex = (int *)allocateFreezeoutArray(nslots * history->ncells * sizeof(int));
+  history->records = new std::vector<double>[nslots];
+  history->lateCells = new std::vector<size_t>[nslots];
+  history->lateRecords = new std::vector<double>[nslots];
+  history->lastStep = -1;
+  history->cubeMin = (double *)allocateFreezeoutArray(2 * history->ncells * sizeof(double));
+  history->cubeMax = (double *)allocateFreezeoutArray(2 * history->ncells * sizeof(double));
+  history->capture = (unsigned char *)allocateFreezeoutArray(history->ncells);
+  history->dilated = (unsigned char *)allocateFreezeoutArray(history->ncells);
+  history->rowStart.resize((size_t)ny * nz + 1);
+  history->capturedCells = 0;
+  history->capturedSteps = 0;
+  history->lateStoredCells = 0;
+  history->foundElements = 0;
+  history->keptElements = 0;
+  memset(history->recordIndex, 0xff, nslots * history->ncells * sizeof(int));
+}
+
+void freeFreezeoutHistory(FREEZEOUT_HISTORY * const history)
+{
+  free(history->energy);
+  free(history->crossing);
+  free(history->recordIndex);
+  delete [] history->records;
+  delete [] history->lateCells;
+  delete [] history->lateRecords;
+  free(history->cubeMin);
+  free(history->cubeMax);
+  free(history->capture);
+  free(history->dilated);
+}
+
+//the blocks of memory that hold the state of the history between two time steps, for a checkpoint (see
+//CheckpointFile.h): the energy density, crossing masks and record indices of the ring, the cube ranges of the last
+//two steps, and the records and late records of each slot, which must have the sizes of the checkpointed run (see
+//freezeoutHistoryRecordSizes)
+void freezeoutHistoryBlocks(FREEZEOUT_HISTORY * const history, std::vector<void *> &data, std::vector<size_t> &sizes)
+{
+  data.push_back(history->energy); sizes.push_back(history->nslots * history->ncells * sizeof(double));
+  data.push_back(history->crossing); sizes.push_back(history->nslots * history->ncells);
+  data.push_back(history->recordIndex); sizes.push_back(history->nslots * history->ncells * sizeof(int));
+  data.push_back(history->cubeMin); sizes.push_back(2 * history->ncells * sizeof(double));
+  data.push_back(history->cubeMax); sizes.push_back(2 * history->ncells * sizeof(double));
+  for (int k = 0; k < history->nslots; k++)
+  {
+    data.push_back(history->records[k].data());
+    sizes.push_back(history->records[k].size() * sizeof(double));
+    data.push_back(history->lateCells[k].data());
+    sizes.push_back(history->lateCells[k].size() * sizeof(size_t));
+    data.push_back(history->lateRecords[k].data());
+    sizes.push_back(history->lateRecords[k].size() * sizeof(double));
+  }
+}
+
+//the sizes of the records, late cells and late records of each slot, 3 * nslots of them
+void freezeoutHistoryRecordSizes(const FREEZEOUT_HISTORY * const history, uint64_t * const recordSizes)
+{
+  for (int k = 0; k < history->nslots; k++)
+  {
+    recordSizes[3*k] = history->records[k].size();
+    recordSizes[3*k+1] = history->lateCells[k].size();
+    recordSizes[3*k+2] = history->lateRecords[k].size();
+  }
+}
+
+void resizeFreezeoutHistoryRecords(FREEZEOUT_HISTORY * const history, const uint64_t * const recordSizes)
+{
+  for (int k = 0; k < history->nslots; k++)
+  {
+    history->records[k].resize(recordSizes[3*k]);
+    history->lateCells[k].resize(recordSizes[3*k+1]);
+    history->lateRecords[k].resize(recordSizes[3*k+2]);
+  }
+}
+
+inline int freezeoutHistorySlot(const FREEZEOUT_HISTORY * const history, int n)
+{
+  return (n + 1) % history->nslots;
+}
+
+//the variables of a cell, or NULL if they are not stored
+inline const double * freezeoutHistoryCell(const FREEZEOUT_HISTORY * const history, int slot, int ix, int iy, int iz)
+{
+  size_t c = ix + history->nx * ((size_t)iy + history->ny * iz);
+  int r = history->recordIndex[slot * history->ncells + c];
+  if (r < 0) return NULL;
+  return &history->records[slot][(size_t)r * NUMBER_FREEZEOUT_VARIABLES];
+}
+
+//the energy density of point p = js * ncells + c of the window of time slices beginning at ring slot slot0
+inline double freezeoutWindowEnergy(const FREEZEOUT_HISTORY * const history, int slot0, size_t p)
+{
+  return history->energy[((slot0 + p / history->ncells) % history->nslots) * history->ncells + p % history->ncells];
+}
+
+inline double freezeoutHistoryEnergy(const FREEZEOUT_HISTORY * const history, int slot, int ix, int iy, int iz)
+{
+  return history->energy[slot * history->ncells + ix + history->nx * ((size_t)iy + history->ny * iz)];
+}
+
+//min and max of the energy density over the corners of the cube of cell c; the corners of the cube coincide along
+//a degenerate axis, whose stride is 0
+inline void freezeoutCubeRange(const double * const eps, size_t c, size_t sx, size_t sy, size_t sz, double &lo, double &hi)
+{
+  double a = eps[c], b = eps[c+sx], d = eps[c+sy], f = eps[c+sx+sy];
+  double g = eps[c+sz], h = eps[c+sx+sz], k = eps[c+sy+sz], l = eps[c+sx+sy+sz];
+  lo = a < b ? a : b;
+  hi = a < b ? b : a;
+  lo = lo < d ? lo : d; hi = hi > d ? hi : d;
+  lo = lo < f ? lo : f; hi = hi > f ? hi : f;
+  lo = lo < g ? lo : g; hi = hi > g ? hi : g;
+  lo = lo < h ? lo : h; hi = hi > h ? hi : h;
+  lo = lo < k ? lo : k; hi = hi > k ? hi : k;
+  lo = lo < l ? lo : l; hi = hi > l ? hi : l;
+}
+
+//the largest change of the energy density at the corners of the cube of cell c since the previous step
+inline double freezeoutCubeChange(const double * const eps, const double * const eps0, size_t c, size_t sx, size_t sy, size_t sz)
+{
+  double a = fabs(eps[c] - eps0[c]), b = fabs(eps[c+sx] - eps0[c+sx]);
+  double d = fabs(eps[c+sy] - eps0[c+sy]), f = fabs(eps[c+sx+sy] - eps0[c+sx+sy]);
+  double g = fabs(eps[c+sz] - eps0[c+sz]), h = fabs(eps[c+sx+sz] - eps0[c+sx+sz]);
+  double k = fabs(eps[c+sy+sz] - eps0[c+sy+sz]), l = fabs(eps[c+sx+sy+sz] - eps0[c+sx+sy+sz]);
+  a = a > b ? a : b; d = d > f ? d : f; g = g > h ? g : h; k = k > l ? k : l;
+  a = a > d ? a : d; g = g > k ? g : k;
+  return a > g ? a : g;
+}
+
+//copy the variables of cell s of the lattice to a record of the history, but for the energy density
+inline void copyFreezeoutRecord(double * const cell, const CONSERVED_VARIABLES * const __restrict__ q,
+                                const FLUID_VELOCITY * const __restrict__ u, int s)
+{
+  cell[0] = (double)(u->ut[s]);
+  cell[1] = (double)(u->ux[s]);
+  cell[2] = (double)(u->uy[s]);
+  cell[3] = (double)(u->un[s]);
 	#ifdef PIMUNU
-        hydrodynamic_evoution[5][1][ix-2][iy-2][iz-2] = (double)(q->pitt[s]);
-        hydrodynamic_evoution[6][1][ix-2][iy-2][iz-2] = (double)(q->pitx[s]);
-        hydrodynamic_evoution[7][1][ix-2][iy-2][iz-2] = (double)(q->pity[s]);
-        hydrodynamic_evoution[8][1][ix-2][iy-2][iz-2] = (double)(q->pitn[s]);
-        hydrodynamic_evoution[9][1][ix-2][iy-2][iz-2] = (double)(q->pixx[s]);
-        hydrodynamic_evoution[10][1][ix-2][iy-2][iz-2] = (double)(q->pixy[s]);
-        hydrodynamic_evoution[11][1][ix-2][iy-2][iz-2] = (double)(q->pixn[s]);
-        hydrodynamic_evoution[12][1][ix-2][iy-2][iz-2] = (double)(q->piyy[s]);
-        hydrodynamic_evoution[13][1][ix-2][iy-2][iz-2] = (double)(q->piyn[s]);
-        hydrodynamic_evoution[14][1][ix-2][iy-2][iz-2] = (double)(q->pinn[s]);
+  cell[5] = (double)(q->pitt[s]);
+  cell[6] = (double)(q->pitx[s]);
+  cell[7] = (double)(q->pity[s]);
+  cell[8] = (double)(q->pitn[s]);
+  cell[9] = (double)(q->pixx[s]);
+  cell[10] = (double)(q->pixy[s]);
+  cell[11] = (double)(q->pixn[s]);
+  cell[12] = (double)(q->piyy[s]);
+  cell[13] = (double)(q->piyn[s]);
+  cell[14] = (double)(q->pinn[s]);
 	#endif
 	#ifdef PI
-        hydrodynamic_evoution[15][1][ix-2][iy-2][iz-2] = (double)(q->Pi[s]);
+  cell[15] = (double)(q->Pi[s]);
 	#endif
+}
+
+//is cell (ix, iy, iz) a corner of a cube whose bit is set in the crossing mask? Along a degenerate axis the cell is
+//in the only cube
+inline int freezeoutCrossingCorner(const unsigned char * const mask, int nx, int ny, int cubesX, int cubesY, int cubesZ,
+                                   int ix, int iy, int iz)
+{
+  for (int kz = iz > 0 ? iz-1 : 0; kz <= iz && kz < cubesZ; kz++)
+    for (int ky = iy > 0 ? iy-1 : 0; ky <= iy && ky < cubesY; ky++)
+      for (int kx = ix > 0 ? ix-1 : 0; kx <= ix && kx < cubesX; kx++)
+        if (mask[kx + (size_t)nx * (ky + ny * kz)]) return 1;
+  return 0;
+}
+
+//store the hydro variables of time step n in its slot of the ring: the energy density of all cells, the crossing
+//masks of the cubes between steps n-1 and n, and all the variables of the cells near the surfaces (see above).
+//qp and up are the variables of step n-1, which the hydro keeps for its next step: those of the corners of the
+//cubes crossing between steps n-1 and n that were not stored with step n-1 are stored late, with step n
+void setHydroVariables(FREEZEOUT_HISTORY * const history,
+                              CONSERVED_VARIABLES * const __restrict__ q, PRECISION * const __restrict__ e,
+                              FLUID_VELOCITY * const __restrict__ u, const CONSERVED_VARIABLES * const __restrict__ qp,
+                              const FLUID_VELOCITY * const __restrict__ up, int n)
+{
+  int nx = history->nx;
+  int ny = history->ny;
+  int nz = history->nz;
+  size_t ncells = history->ncells;
+  int nsurfaces = history->nsurfaces;
+  const double * const eFs = history->freezeoutEnergyDensities;
+  int slot = freezeoutHistorySlot(history, n);
+  int previous = (history->lastStep == n - 1) ? freezeoutHistorySlot(history, n - 1) : -1;
+  history->lastStep = n;
+
+  double * const eps = history->energy + slot * ncells;
+  #pragma omp parallel for collapse(2)
+  for (int iz = 2; iz < nz+2; iz++)
+  {
+    for (int iy = 2; iy < ny+2; iy++)
+    {
+      double * const row = eps + (size_t)nx * ((iy-2) + ny * (iz-2));
+      for (int ix = 2; ix < nx+2; ix++) row[ix-2] = (double)(e[columnMajorLinearIndex(ix, iy, iz, nx+4, ny+4)]);
+    }
+  }
+
+  //the range of the energy density over the corners of each cube, the crossings between the last two steps and
+  //the cubes that may cross before the next one. Without a previous step, all cells are stored
+  //the cubes of the cells along a degenerate axis have both corners in its only cell
+  int cubesX = nx > 1 ? nx-1 : 1;
+  int cubesY = ny > 1 ? ny-1 : 1;
+  int cubesZ = nz > 1 ? nz-1 : 1;
+  size_t sx = history->strides[0];
+  size_t sy = history->strides[1];
+  size_t sz = history->strides[2];
+  double * const lo1 = history->cubeMin + (n & 1) * ncells;
+  double * const hi1 = history->cubeMax + (n & 1) * ncells;
+  const double * const lo0 = history->cubeMin + ((n + 1) & 1) * ncells;
+  const double * const hi0 = history->cubeMax + ((n + 1) & 1) * ncells;
+  const double * const eps0 = history->energy + (previous < 0 ? slot : previous) * ncells;
+  unsigned char * const mask = history->crossing + (previous < 0 ? slot : previous) * ncells;
+  unsigned char * const capture = history->capture;
+  memset(mask, 0, ncells);
+  memset(capture, previous < 0, ncells);
+  #pragma omp parallel for collapse(2)
+  for (int iz = 0; iz < cubesZ; iz++)
+  {
+    for (int iy = 0; iy < cubesY; iy++)
+    {
+      size_t c0 = (size_t)nx * (iy + ny * iz);
+      if (previous < 0)
+      {
+        #pragma omp simd
+        for (int ix = 0; ix < cubesX; ix++) freezeoutCubeRange(eps, c0 + ix, sx, sy, sz, lo1[c0 + ix], hi1[c0 + ix]);
+        continue;
+      }
+      #pragma omp simd
+      for (int ix = 0; ix < cubesX; ix++)
+      {
+        size_t c = c0 + ix;
+        double lo, hi;
+        freezeoutCubeRange(eps, c, sx, sy, sz, lo, hi);
+        lo1[c] = lo;
+        hi1[c] = hi;
+        double change = freezeoutCubeChange(eps, eps0, c, sx, sy, sz);
+        double lo01 = lo < lo0[c] ? lo : lo0[c];
+        double hi01 = hi > hi0[c] ? hi : hi0[c];
+        double lo12 = lo - FREEZEOUT_CAPTURE_EXTRAPOLATION * change;
+        double hi12 = hi + FREEZEOUT_CAPTURE_EXTRAPOLATION * change;
+        int m = 0, predicted = 0;
+        for (int isurface = 0; isurface < nsurfaces; isurface++)
+        {
+          m |= ((lo01 < eFs[isurface]) & (hi01 >= eFs[isurface])) << isurface;
+          predicted |= (lo12 < eFs[isurface]) & (hi12 >= eFs[isurface]);
+        }
+        mask[c] = m;
+        capture[c] = (m != 0) | predicted;
+      }
+    }
+  }
+
+  //the cells at the corners of the cubes within the margin of a captured cube: a cell is needed by the cubes
+  //c - 1 - margin .. c + margin in each direction. The dilation is done one direction at a time, on whole rows;
+  //along a degenerate axis there is nothing to dilate
+  unsigned char * const dilated = history->dilated;
+  const int margin = FREEZEOUT_CAPTURE_MARGIN;
+  if (previous >= 0)
+  {
+    #pragma omp parallel for collapse(2)
+    for (int iz = 0; iz < nz; iz++)
+    {
+      for (int iy = 0; iy < ny; iy++)
+      {
+        const unsigned char * const in = capture + (size_t)nx * (iy + ny * iz);
+        unsigned char * const out = dilated + (size_t)nx * (iy + ny * iz);
+        memset(out, 0, nx);
+        for (int d = -margin; d <= margin + 1; d++)
+        {
+          int i0 = d > 0 ? d : 0;
+          int i1 = d > 0 ? nx : nx + d;
+          #pragma omp simd
+          for (int ix = i0; ix < i1; ix++) out[ix] |= in[ix - d];
+        }
+      }
+    }
+    //the result of the x pass is in dilated; the y and z passes go back and forth between the two masks
+    unsigned char *in = dilated, *out = capture;
+    for (int pass = 0; pass < 2; pass++)
+    {
+      //pass 0 dilates in y, pass 1 in z
+      size_t stride = pass ? (size_t)nx * ny : nx;
+      int n1 = pass ? nz : ny;
+      if (n1 < 2) continue;
+      #pragma omp parallel for collapse(2)
+      for (int iz = 0; iz < nz; iz++)
+      {
+        for (int iy = 0; iy < ny; iy++)
+        {
+          int i = pass ? iz : iy;
+          unsigned char * const row = out + (size_t)nx * (iy + ny * iz);
+          memset(row, 0, nx);
+          for (int j = i - margin - 1; j <= i + margin; j++)
+          {
+            if (j < 0 || j >= n1) continue;
+            const unsigned char * const from = in + (size_t)nx * (iy + ny * iz) + (j - i) * (long)stride;
+            #pragma omp simd
+            for (int ix = 0; ix < nx; ix++) row[ix] |= from[ix];
+          }
+        }
+      }
+      unsigned char * const swap = in;
+      in = out;
+      out = swap;
+    }
+    if (in != capture) memcpy(capture, in, ncells);
+  }
+
+  //the corners of the crossing cubes whose variables at step n-1 are not stored, because the crossing was not
+  //predicted; the late cells are numbered row by row, and their variables copied from those the hydro keeps
+  int nrows = ny * nz;
+  std::vector<size_t> &rowStart = history->rowStart;
+  unsigned char * const late = dilated;
+  const int * const recordIndex0 = history->recordIndex + (previous < 0 ? slot : previous) * ncells;
+  #pragma omp parallel for
+  for (int row = 0; row < nrows; row++)
+  {
+    int iy = row % ny;
+    int iz = row / ny;
+    unsigned char * const out = late + (size_t)nx * row;
+    size_t count = 0;
+    for (int ix = 0; ix < nx; ix++)
+    {
+      size_t c = ix + (size_t)nx * row;
+      out[ix] = previous >= 0 && recordIndex0[c] < 0 && freezeoutCrossingCorner(mask, nx, ny, cubesX, cubesY, cubesZ, ix, iy, iz);
+      count += out[ix];
+    }
+    rowStart[row + 1] = count;
+  }
+  rowStart[0] = 0;
+  for (int row = 0; row < nrows; row++) rowStart[row + 1] += rowStart[row];
+  size_t nlate = rowStart[nrows];
+  history->lateStoredCells += nlate;
+  std::vector<size_t> &lateCells = history->lateCells[slot];
+  std::vector<double> &lateRecords = history->lateRecords[slot];
+  lateCells.resize(nlate);
+  lateRecords.resize(nlate * NUMBER_FREEZEOUT_VARIABLES);
+  if (nlate > 0)
+  {
+    #pragma omp parallel for
+    for (int row = 0; row < nrows; row++)
+    {
+      int iy = row % ny;
+      int iz = row / ny;
+      size_t r = rowStart[row];
+      for (int ix = 0; ix < nx; ix++)
+      {
+        size_t c = ix + (size_t)nx * row;
+        if (!late[c]) continue;
+        lateCells[r] = c;
+        double * const cell = &lateRecords[r * NUMBER_FREEZEOUT_VARIABLES];
+        copyFreezeoutRecord(cell, qp, up, columnMajorLinearIndex(ix+2, iy+2, iz+2, nx+4, ny+4));
+        cell[4] = eps0[c];
+        r++;
+      }
+    }
+  }
+
+  //number the captured cells row by row and copy their variables
+  #pragma omp parallel for
+  for (int row = 0; row < nrows; row++)
+  {
+    const unsigned char * const in = capture + (size_t)nx * row;
+    size_t count = 0;
+    for (int ix = 0; ix < nx; ix++) count += in[ix];
+    rowStart[row + 1] = count;
+  }
+  rowStart[0] = 0;
+  for (int row = 0; row < nrows; row++) rowStart[row + 1] += rowStart[row];
+  size_t ncaptured = rowStart[nrows];
+  history->capturedCells += ncaptured;
+  history->capturedSteps++;
+  std::vector<double> &records = history->records[slot];
+  if (records.size() < ncaptured * NUMBER_FREEZEOUT_VARIABLES) records.resize(ncaptured * NUMBER_FREEZEOUT_VARIABLES);
+  int * const recordIndex = history->recordIndex + slot * ncells;
+  #pragma omp parallel for
+  for (int row = 0; row < nrows; row++)
+  {
+    int iy = row % ny;
+    int iz = row / ny;
+    size_t r = rowStart[row];
+    for (int ix = 0; ix < nx; ix++)
+    {
+      size_t c = ix + (size_t)nx * row;
+      if (!capture[c])
+      {
+        recordIndex[c] = -1;
+        continue;
       }
+      recordIndex[c] = r;
+      int s = columnMajorLinearIndex(ix+2, iy+2, iz+2, nx+4, ny+4);
+      double * const cell = &records[r * NUMBER_FREEZEOUT_VARIABLES];
+      r++;
+      copyFreezeoutRecord(cell, q, u, s);
+      cell[4] = (double)(e[s]);
     }
   }
 }
 
-void setHydroVariables(double ****energy_density_evoution, double *****hydrodynamic_evoution,
-                              CONSERVED_VARIABLES * const __restrict__ q, PRECISION * const __restrict__ e,
-                              FLUID_VELOCITY * const __restrict__ u, int nx, int ny, int nz, int FOFREQ, int n)
+//the variables of a cell at the step before slot k, stored late with slot k, or NULL if they are not stored
+inline const double * freezeoutHistoryLateCell(const FREEZEOUT_HISTORY * const history, int slot, int ix, int iy, int iz)
+{
+  size_t c = ix + history->nx * ((size_t)iy + history->ny * iz);
+  const std::vector<size_t> &cells = history->lateCells[slot];
+  std::vector<size_t>::const_iterator i = std::lower_bound(cells.begin(), cells.end(), c);
+  if (i == cells.end() || *i != c) return NULL;
+  return &history->lateRecords[slot][(i - cells.begin()) * NUMBER_FREEZEOUT_VARIABLES];
+}
+
+//copy the variables of a corner of a hypercube. The cubes crossing a surface between steps n-1 and n are known
+//when step n is stored, so the corners at step n are always stored; a corner at step n-1 was stored late, with
+//step n, if the crossing was not predicted. A corner that is stored neither way is an error
+inline void gatherFreezeoutCorner(double * const corner, const FREEZEOUT_HISTORY * const history, int it0, int it1, int jt,
+                                  int ix, int iy, int iz)
 {
-  int nFO = n % FOFREQ;
-  #pragma omp parallel for collapse(3)
-  for (int ix = 2; ix < nx+2; ix++)
+  const double *cell = freezeoutHistoryCell(history, jt ? it1 : it0, ix, iy, iz);
+  if (cell == NULL && !jt) cell = freezeoutHistoryLateCell(history, it1, ix, iy, iz);
+  if (cell == NULL)
   {
-    for (int iy = 2; iy < ny+2; iy++)
+    printf("The variables of the freezeout hypercube corner (%d, %d, %d) in slot %d of the history were not stored!\n",
+      ix, iy, iz, jt ? it1 : it0);
+    exit(-1);
+  }
+  memcpy(corner, cell, NUMBER_FREEZEOUT_VARIABLES * sizeof(double));
+  corner[FREEZEOUT_ENERGY_DENSITY] = freezeoutHistoryEnergy(history, jt ? it1 : it0, ix, iy, iz);
+}
+
+//gather the hydro variables at the corners of the DIM dimensional hypercube of cell (ix, iy, iz), spanned by the time
+//slices in the ring slots it0 and it1 and the spatial axes of the history. Corner c is stored at
+//corners + c * NUMBER_FREEZEOUT_VARIABLES, where bit DIM-1 of c is its offset in time and bit DIM-2-k its offset along
+//spatial axis k (in 3+1D c = 8*jt + 4*jx + 2*jy + jz), so the corners are read from the history once per cell and
+//shared by all its elements and isotherms
+template <int DIM>
+void gatherHypercube(double * const corners, const FREEZEOUT_HISTORY * const history, int it0, int it1, int ix, int iy, int iz)
+{
+  for (int c = 0; c < (1 << DIM); c++)
+  {
+    int cell[3] = {ix, iy, iz};
+    for (int k = 0; k < DIM-1; k++) cell[history->axes[k]] += (c >> (DIM-2-k)) & 1;
+    gatherFreezeoutCorner(corners + c * NUMBER_FREEZEOUT_VARIABLES, history, it0, it1, c >> (DIM-1),
+      cell[0], cell[1], cell[2]);
+  }
+}
+
+//the energy density at the corners, in the nested arrays cornelius takes
+void writeEnergyDensityToHypercube4D(double ****hyperCube, const double * const corners)
+{
+  for (int jt = 0; jt < 2; jt++)
+    for (int jx = 0; jx < 2; jx++)
+      for (int jy = 0; jy < 2; jy++)
+        for (int jz = 0; jz < 2; jz++)
+          hyperCube[jt][jx][jy][jz] = corners[(8*jt + 4*jx + 2*jy + jz) * NUMBER_FREEZEOUT_VARIABLES + FREEZEOUT_ENERGY_DENSITY];
+}
+void writeEnergyDensityToHypercube3D(double ***hyperCube, const double * const corners)
+{
+  for (int jt = 0; jt < 2; jt++)
+    for (int jx = 0; jx < 2; jx++)
+      for (int jy = 0; jy < 2; jy++)
+        hyperCube[jt][jx][jy] = corners[(4*jt + 2*jx + jy) * NUMBER_FREEZEOUT_VARIABLES + FREEZEOUT_ENERGY_DENSITY];
+}
+void writeEnergyDensityToHypercube2D(double **hyperCube, const double * const corners)
+{
+  for (int jt = 0; jt < 2; jt++)
+    for (int jx = 0; jx < 2; jx++)
+      hyperCube[jt][jx] = corners[(2*jt + jx) * NUMBER_FREEZEOUT_VARIABLES + FREEZEOUT_ENERGY_DENSITY];
+}
+
+//the order in which the corner terms of the interpolation are summed: by the number of offsets, then by decreasing
+//corner number (in 3+1D 0000, 1000, 0100, 0010, 0001, 1100, ...), that of the formula for a single variable
+template <int DIM>
+struct HypercubeSumOrder
+{
+  int corner[1 << DIM];
+  HypercubeSumOrder()
+  {
+    int k = 0;
+    for (int offsets = 0; offsets <= DIM; offsets++)
+      for (int c = (1 << DIM) - 1; c >= 0; c--)
+        if (__builtin_popcount(c) == offsets) corner[k++] = c;
+  }
+};
+
+//multilinear interpolation of all NUMBER_FREEZEOUT_VARIABLES hydro variables at the fractions frac[0..DIM-1] of the
+//lattice spacings (time first) inside the gathered hypercube. The 2^DIM corner weights are computed once and applied
+//to all variables in a vectorized loop; the corner terms are summed in a fixed order (HypercubeSumOrder), so results
+//do not depend on the vector width
+template <int DIM>
+void interpolateHypercube(const double * const __restrict__ corners, const double * const frac, double * const __restrict__ values)
+{
+  static const HypercubeSumOrder<DIM> order;
+  double f[DIM][2];
+  for (int k = 0; k < DIM; k++)
+  {
+    f[k][0] = 1 - frac[k];
+    f[k][1] = frac[k];
+  }
+  double weight[1 << DIM];
+  for (int k = 0; k < (1 << DIM); k++)
+  {
+    int c = order.corner[k];
+    double w = f[0][c >> (DIM-1)];
+    for (int j = 1; j < DIM; j++) w *= f[j][(c >> (DIM-1-j)) & 1];
+    weight[k] = w;
+  }
+  const double * const a0 = corners + order.corner[0] * NUMBER_FREEZEOUT_VARIABLES;
+  #pragma omp simd
+  for (int ivar = 0; ivar < NUMBER_FREEZEOUT_VARIABLES; ivar++) values[ivar] = weight[0] * a0[ivar];
+  for (int k = 1; k < (1 << DIM); k++)
+  {
+    const double w = weight[k];
+    const double * const a = corners + order.corner[k] * NUMBER_FREEZEOUT_VARIABLES;
+    #pragma omp simd
+    for (int ivar = 0; ivar < NUMBER_FREEZEOUT_VARIABLES; ivar++) values[ivar] += w * a[ivar];
+  }
+}
+
+//optional coalescing of the surface elements (freezeoutCoalescingCells in hydro.properties): with fine lattices
+//cornelius emits many small, nearly coplanar elements. The elements found in a tile of cells^(dim-1) neighbouring
+//cells of a time slice are merged when their normals and fluid fields agree with those of the first element of the
+//merge within the tolerances. A merged element has the sum of the dsigma_mu of its elements, and the energy density
+//that conserves their energy flux e u^mu dsigma_mu; its position, u^mu (normalized again), pi^{mu nu} and Pi are the
+//averages of theirs weighted by the size of the elements
+typedef struct
+{
+  int cells; //edge of a tile in cells, 0 for no coalescing
+  double normalTolerance; //largest 1 - cos of the angle between two normals
+  double fieldTolerance; //largest difference of the Cartesian u^mu, relative to u^t, and of e, pi^{mu nu} and Pi, relative to e
+} FREEZEOUT_COALESCING;
+
+//the values accumulated for each merged element
+#define FREEZEOUT_COALESCING_SUMS 27
+
+//the size of an element, the length of its normal with the eta component in fm^3, the weight of its position and
+//fields in a merged element
+inline double freezeoutElementSize(const double * const element)
+{
+  double dsn = element[7] / element[0];
+  return sqrt(element[4]*element[4] + element[5]*element[5] + element[6]*element[6] + dsn*dsn);
+}
+
+//the normal dsigma_mu and the flow velocity u^mu of an element in Cartesian coordinates t, x, y, z
+inline void freezeoutElementCartesian(const double * const element, double * const dsigma, double * const u)
+{
+  const double tau = element[0];
+  const double ch = cosh(element[3]);
+  const double sh = sinh(element[3]);
+  const double dsn = element[7] / tau;
+  const double un = tau * element[11];
+  dsigma[0] = ch * element[4] - sh * dsn;
+  dsigma[1] = element[5];
+  dsigma[2] = element[6];
+  dsigma[3] = ch * dsn - sh * element[4];
+  u[0] = ch * element[8] + sh * un;
+  u[1] = element[9];
+  u[2] = element[10];
+  u[3] = sh * element[8] + ch * un;
+}
+
+//whether element b agrees with element a within the tolerances. The normals and flow velocities are compared in
+//Cartesian coordinates, so that elements at different rapidities, which emit at different longitudinal momenta, are
+//not merged; the eta components of pi^{mu nu} are compared in the units of the others, multiplied by tau for each
+//eta index
+bool freezeoutElementsAgree(const double * const a, const double * const b, const FREEZEOUT_COALESCING * const coalescing)
+{
+  static const int etaIndices[10] = {0, 0, 0, 1, 0, 0, 1, 0, 1, 2};
+  double dsa[4], dsb[4], ua[4], ub[4];
+  freezeoutElementCartesian(a, dsa, ua);
+  freezeoutElementCartesian(b, dsb, ub);
+  double sa = 0, sb = 0, cosine = 0;
+  for (int mu = 0; mu < 4; mu++)
+  {
+    sa += dsa[mu] * dsa[mu];
+    sb += dsb[mu] * dsb[mu];
+    cosine += dsa[mu] * dsb[mu];
+  }
+  if (sa == 0 || sb == 0) return false;
+  if (1 - cosine / sqrt(sa * sb) > coalescing->normalTolerance) return false;
+
+  const double du = coalescing->fieldTolerance * ua[0];
+  for (int mu = 0; mu < 4; mu++)
+    if (fabs(ub[mu] - ua[mu]) > du) return false;
+  const double de = coalescing->fieldTolerance * a[12];
+  if (fabs(b[12] - a[12]) > de || fabs(b[25] - a[25]) > de) return false;
+  for (int k = 0; k < 10; k++)
+  {
+    double ta = etaIndices[k] == 0 ? 1 : (etaIndices[k] == 1 ? a[0] : a[0]*a[0]);
+    double tb = etaIndices[k] == 0 ? 1 : (etaIndices[k] == 1 ? b[0] : b[0]*b[0]);
+    if (fabs(tb*b[15+k] - ta*a[15+k]) > de) return false;
+  }
+  return true;
+}
+
+//merge the nelements elements of rows (FREEZEOUT_SURFACE_COLUMNS values each, T and P are not used) in place, in the
+//order of their first elements; returns the number of elements left. T and P of the merged elements are not set
+int coalesceFreezeoutElements(double * const rows, int nelements, const FREEZEOUT_COALESCING * const coalescing,
+                              std::vector<double> &sums, std::vector<int> &first, std::vector<int> &count)
+{
+  const int C = FREEZEOUT_SURFACE_COLUMNS;
+  const int S = FREEZEOUT_COALESCING_SUMS;
+  sums.assign(nelements * S, 0.0);
+  first.resize(nelements);
+  count.resize(nelements);
+  int nmerged = 0;
+  for (int i = 0; i < nelements; i++)
+  {
+    const double * const element = &rows[i * C];
+    int j = 0;
+    while (j < nmerged && !freezeoutElementsAgree(&rows[first[j] * C], element, coalescing)) j++;
+    if (j == nmerged)
+    {
+      first[nmerged] = i;
+      count[nmerged++] = 0;
+    }
+    count[j]++;
+    //size, size * position, dsigma_mu, size * u^mu, size * e, size * pi^{mu nu}, size * Pi, energy flux, |u.dsigma|
+    double * const sum = &sums[j * S];
+    const double a = freezeoutElementSize(element);
+    const double udsigma = element[8]*element[4] + element[9]*element[5] + element[10]*element[6] + element[11]*element[7];
+    sum[0] += a;
+    for (int mu = 0; mu < 4; mu++)
+    {
+      sum[1+mu] += a * element[mu];
+      sum[5+mu] += element[4+mu];
+      sum[9+mu] += a * element[8+mu];
+    }
+    sum[13] += a * element[12];
+    for (int k = 0; k < 10; k++) sum[14+k] += a * element[15+k];
+    sum[24] += a * element[25];
+    sum[25] += element[12] * udsigma;
+    sum[26] += fabs(udsigma);
+  }
+
+  //the first element of merge j is not before j, so the merged elements can be written in place in increasing order
+  for (int j = 0; j < nmerged; j++)
+  {
+    double * const element = &rows[j * C];
+    if (count[j] == 1)
+    {
+      if (first[j] != j) memcpy(element, &rows[first[j] * C], C * sizeof(double));
+      continue;
+    }
+    const double * const sum = &sums[j * S];
+    for (int mu = 0; mu < 4; mu++)
+    {
+      element[mu] = sum[1+mu] / sum[0];
+      element[4+mu] = sum[5+mu];
+    }
+    const double tau = element[0];
+    for (int mu = 1; mu < 4; mu++) element[8+mu] = sum[9+mu] / sum[0];
+    element[8] = sqrt(1 + element[9]*element[9] + element[10]*element[10] + tau*tau*element[11]*element[11]);
+    //the energy flux is conserved, unless the merged element is (nearly) tangent to the flow
+    const double udsigma = element[8]*element[4] + element[9]*element[5] + element[10]*element[6] + element[11]*element[7];
+    element[12] = fabs(udsigma) > 1e-3 * sum[26] ? sum[25] / udsigma : sum[13] / sum[0];
+    element[13] = 0;
+    element[14] = 0;
+    for (int k = 0; k < 10; k++) element[15+k] = sum[14+k] / sum[0];
+    element[25] = sum[24] / sum[0];
+  }
+  return nmerged;
+}
+
+//search the time slices it = start .. nit of the history for the freezeout surfaces of the nsurfaces isotherms
+//freezeoutEnergyDensities, and write the surface elements (centroid, normal and interpolated hydro variables) of each
+//to its own surface file. The isotherms share the crossing masks and the gather of the hydro variables of a cell.
+//The cells crossing a surface are searched in parallel, each thread with its own cornelius instances and element
+//buffers; the buffered elements are written in (it, ix, iy, iz) order, so the files do not depend on the number of threads.
+//the proper time of slice it is t0 + (itOffset + it) * dt, the normals are scaled by the current time t.
+//the elements are coalesced (see FREEZEOUT_COALESCING) unless coalescing is NULL or its cells is 0
+void findFreezeoutSurface(FREEZEOUT_HISTORY * const history, int slot0, int start, int nit, int itOffset,
+                          int dim, int nsurfaces, const double * const freezeoutEnergyDensities, double *lattice_spacing,
+                          double t, double t0, double dt, double dx, double dy, double dz, int writeCellTau,
+                          FREEZEOUT_SURFACE_FILE * const surfaces, COOPER_FRYE_SPECTRA * const spectra,
+                          const FREEZEOUT_COALESCING * const coalescing)
+{
+  int nx = history->nx;
+  int ny = history->ny;
+  int nz = history->nz;
+  //the cells of the hypercubes; along a degenerate axis there is one, whose cube has both corners in it
+  int cubesX = nx > 1 ? nx-1 : 1;
+  int cubesY = ny > 1 ? ny-1 : 1;
+  int cubesZ = nz > 1 ? nz-1 : 1;
+  const int * const axes = history->axes;
+
+  //the cells whose hypercube crosses a freezeout energy density, i.e. min < eF <= max over its corners, are marked
+  //in the crossing masks when the steps are stored (see setHydroVariables). This is the same test cornelius applies
+  //before constructing a cube, so only these cells are handed to it
+  int nslices = nit - start + 1;
+  size_t ncells = history->ncells;
+  const int nslots = history->nslots;
+  long foundElements = 0, keptElements = 0;
+  //the elements of a tile of tile^(dim-1) cells of a slice are coalesced together; without coalescing each cell is
+  //a tile of its own
+  const bool coalesce = coalescing && coalescing->cells > 0;
+  const int tile = coalesce ? coalescing->cells : 1;
+  //compact list of the crossing cells and their masks in (it, ix, iy, iz) order of the tiles, and of the cells in
+  //each tile, and the first cell of each tile that has crossing cells
+  std::vector<int> cells, tiles;
+  for (int it = start; it < nit; it++)
+  {
+    const unsigned char * const mask = history->crossing + ((slot0 + it) % nslots) * ncells;
+    for (int tx = 0; tx < cubesX; tx += tile)
+      for (int ty = 0; ty < cubesY; ty += tile)
+        for (int tz = 0; tz < cubesZ; tz += tile)
+        {
+          tiles.push_back(cells.size() / 5);
+          for (int ix = tx; ix < tx + tile && ix < cubesX; ix++)
+            for (int iy = ty; iy < ty + tile && iy < cubesY; iy++)
+              for (int iz = tz; iz < tz + tile && iz < cubesZ; iz++)
+              {
+                int m = mask[ix + (size_t)nx * (iy + ny * iz)];
+                if (!m) continue;
+                cells.push_back(it);
+                cells.push_back(ix);
+                cells.push_back(iy);
+                cells.push_back(iz);
+                cells.push_back(m);
+              }
+          if (tiles.back() == (int)cells.size() / 5) tiles.pop_back();
+        }
+  }
+  int ncrossing = cells.size() / 5;
+  tiles.push_back(ncrossing);
+
+  //the crossing cells are searched in blocks of whole tiles of at least blockSize cells; each block is buffered by
+  //the thread that searched it, in one buffer per isotherm
+  const int blockSize = 32;
+  std::vector<int> blockTiles(1, 0);
+  for (int itile = 1; itile < (int)tiles.size(); itile++)
+    if (tiles[itile] - tiles[blockTiles.back()] >= blockSize || itile == (int)tiles.size() - 1) blockTiles.push_back(itile);
+  int nblocks = blockTiles.size() - 1;
+  if (nblocks == 0) return;
+
+  //edge crossing cache: a lattice edge is shared by up to 2^(dim-1) cells, so the point where an isotherm crosses
+  //it is computed once for all of them. The lattice points at the corners of the crossing cells are numbered, and
+  //for each of them and each direction (t and the spatial axes) the crossing of the edge to the next point is
+  //computed in a simd loop, the way cornelius computes it: (e0-eF)/(e0-e1), 1e-9 or 1-1e-9 if an end is at eF,
+  //NaN if not crossed
+  const int ncorners = 1 << dim;
+  size_t stride[4] = {ncells};
+  for (int axis = 1; axis < dim; axis++) stride[axis] = history->strides[axes[axis-1]];
+  size_t cornerOffset[16];
+  for (int jc = 0; jc < ncorners; jc++)
+  {
+    cornerOffset[jc] = 0;
+    for (int axis = 0; axis < dim; axis++) cornerOffset[jc] += ((jc >> (dim - 1 - axis)) & 1) * stride[axis];
+  }
+  std::vector<int> pointIndex(nslices * ncells, -1);
+  std::vector<size_t> points;
+  for (int icell = 0; icell < ncrossing; icell++)
+  {
+    size_t p0 = (cells[5*icell] - start) * ncells + cells[5*icell+1] + (size_t)nx * (cells[5*icell+2] + ny * cells[5*icell+3]);
+    for (int jc = 0; jc < ncorners; jc++)
     {
-      for (int iz = 2; iz < nz+2; iz++)
+      size_t p = p0 + cornerOffset[jc];
+      if (pointIndex[p] >= 0) continue;
+      pointIndex[p] = points.size();
+      points.push_back(p);
+    }
+  }
+  size_t npoints = points.size();
+  std::vector<double> e0(npoints), e1(dim * npoints), edgeCuts(nsurfaces * dim * npoints);
+  #pragma omp parallel for
+  for (size_t q = 0; q < npoints; q++)
+  {
+    size_t p = points[q];
+    size_t c = p % ncells;
+    int position[3] = {(int)(c % nx), (int)((c / nx) % ny), (int)(c / ((size_t)nx * ny))};
+    int lattice[3] = {nx, ny, nz};
+    int index[4] = {(int)(p / ncells)}, size[4] = {nslices};
+    for (int axis = 1; axis < dim; axis++)
+    {
+      index[axis] = position[axes[axis-1]];
+      size[axis] = lattice[axes[axis-1]];
+    }
+    e0[q] = freezeoutWindowEnergy(history, slot0 + start, p);
+    //the points on the upper boundary have no edge in that direction
+    for (int axis = 0; axis < dim; axis++)
+      e1[axis * npoints + q] = freezeoutWindowEnergy(history, slot0 + start, index[axis] < size[axis] - 1 ? p + stride[axis] : p);
+  }
+  for (int isurface = 0; isurface < nsurfaces; isurface++)
+  {
+    const double eF = freezeoutEnergyDensities[isurface];
+    for (int axis = 0; axis < dim; axis++)
+    {
+      const double * const v1 = &e0[0];
+      const double * const v2 = &e1[axis * npoints];
+      double * const cut = &edgeCuts[(isurface * dim + axis) * npoints];
+      #pragma omp parallel for simd
+      for (size_t q = 0; q < npoints; q++)
       {
-        int s = columnMajorLinearIndex(ix, iy, iz, nx+4, ny+4);
-        energy_density_evoution[nFO+1][ix-2][iy-2][iz-2] = (double)e[s];
-        hydrodynamic_evoution[0][nFO+1][ix-2][iy-2][iz-2] = (double)(u->ut[s]);
-        hydrodynamic_evoution[1][nFO+1][ix-2][iy-2][iz-2] = (double)(u->ux[s]);
-        hydrodynamic_evoution[2][nFO+1][ix-2][iy-2][iz-2] = (double)(u->uy[s]);
-        hydrodynamic_evoution[3][nFO+1][ix-2][iy-2][iz-2] = (double)(u->un[s]);
-        hydrodynamic_evoution[4][nFO+1][ix-2][iy-2][iz-2] = (double)(e[s]);
-	#ifdef PIMUNU
-        hydrodynamic_evoution[5][nFO+1][ix-2][iy-2][iz-2] = (double)(q->pitt[s]);
-        hydrodynamic_evoution[6][nFO+1][ix-2][iy-2][iz-2] = (double)(q->pitx[s]);
-        hydrodynamic_evoution[7][nFO+1][ix-2][iy-2][iz-2] = (double)(q->pity[s]);
-        hydrodynamic_evoution[8][nFO+1][ix-2][iy-2][iz-2] = (double)(q->pitn[s]);
-        hydrodynamic_evoution[9][nFO+1][ix-2][iy-2][iz-2] = (double)(q->pixx[s]);
-        hydrodynamic_evoution[10][nFO+1][ix-2][iy-2][iz-2] = (double)(q->pixy[s]);
-        hydrodynamic_evoution[11][nFO+1][ix-2][iy-2][iz-2] = (double)(q->pixn[s]);
-        hydrodynamic_evoution[12][nFO+1][ix-2][iy-2][iz-2] = (double)(q->piyy[s]);
-        hydrodynamic_evoution[13][nFO+1][ix-2][iy-2][iz-2] = (double)(q->piyn[s]);
-        hydrodynamic_evoution[14][nFO+1][ix-2][iy-2][iz-2] = (double)(q->pinn[s]);
-	#endif
-	#ifdef PI
-        hydrodynamic_evoution[15][nFO+1][ix-2][iy-2][iz-2] = (double)(q->Pi[s]);
-	#endif
+        double f = (v1[q] - eF) / (v1[q] - v2[q]);
+        double atSurface = (v1[q] == eF && v2[q] < eF) ? 1e-9 : ((v2[q] == eF && v1[q] < eF) ? 1.0-1e-9 : NAN);
+        cut[q] = ((v1[q] - eF) * (v2[q] - eF) < 0) ? f : atSurface;
+      }
+    }
+  }
+  //the elements are written to the surface files and/or added to the spectra of each isotherm; either can be NULL
+  std::vector<std::string> buffers(omp_get_max_threads() * nsurfaces);
+  const int ngroups = spectra && nblocks > COOPER_FRYE_GROUPS ? COOPER_FRYE_GROUPS : nblocks;
+  std::vector<int> blockThread(nblocks), blockElements(nblocks * nsurfaces);
+  std::vector<size_t> blockBegin(nblocks * nsurfaces), blockEnd(nblocks * nsurfaces);
+
+  #pragma omp parallel reduction(+:foundElements,keptElements)
+  {
+    int thread = omp_get_thread_num();
+    Cornelius *cor = new Cornelius[nsurfaces];
+    for (int isurface = 0; isurface < nsurfaces; isurface++)
+    {
+      cor[isurface].init(dim, freezeoutEnergyDensities[isurface], lattice_spacing);
+      buffers[thread * nsurfaces + isurface].clear();
+    }
+    //the hypercube of cornelius, of the dimension of the history
+    double ****hyperCube4D = NULL;
+    double ***hyperCube3D = NULL;
+    double **hyperCube2D = NULL;
+    if (dim == 4) hyperCube4D = calloc4dArray(hyperCube4D, 2, 2, 2, 2);
+    else if (dim == 3) hyperCube3D = calloc3dArray(hyperCube3D, 2, 2, 2);
+    else if (dim == 2) hyperCube2D = calloc2dArray(hyperCube2D, 2, 2);
+    double corners[16 * NUMBER_FREEZEOUT_VARIABLES];
+    //the cached crossings of the edges of a cell, in the numbering of cornelius: the edge from corner jc in
+    //direction k (k = 0..3 for t, x, y, z in 3+1D, k = 1..3 for t and the two axes in 2+1D, ...) is cuts[16*k + jc]
+    int pointIds[16];
+    double cuts[16 * 4];
+    //the centroid and normal of an element, time first, then the spatial axes of the history
+    double centroid[4], normal[4];
+    //the elements of one tile for each isotherm, their energy density, temperature and pressure, and the scratch
+    //space of the coalescing
+    std::vector<std::vector<double> > tileRows(nsurfaces);
+    std::vector<double> eBatch, TBatch, PBatch, sums;
+    std::vector<int> first, count;
+
+    //the blocks are searched in groups of consecutive blocks, each by one thread, so that the elements of a group are
+    //added to its accumulator of the spectra in the same order whatever the number of threads and the schedule
+    #pragma omp for schedule(dynamic)
+    for (int group = 0; group < ngroups; group++)
+    {
+      for (int block = group * nblocks / ngroups; block < (group + 1) * nblocks / ngroups; block++)
+      {
+        blockThread[block] = thread;
+        for (int isurface = 0; isurface < nsurfaces; isurface++)
+        {
+          blockBegin[block * nsurfaces + isurface] = buffers[thread * nsurfaces + isurface].size();
+          blockElements[block * nsurfaces + isurface] = 0;
+        }
+        for (int itile = blockTiles[block]; itile < blockTiles[block+1]; itile++)
+        {
+          for (int icell = tiles[itile]; icell < tiles[itile+1]; icell++)
+          {
+            int it = cells[5*icell];
+            int ix = cells[5*icell+1];
+            int iy = cells[5*icell+2];
+            int iz = cells[5*icell+3];
+            int mask = cells[5*icell+4];
+            int it0 = (slot0 + it) % history->nslots;
+            int it1 = (slot0 + it + 1) % history->nslots;
+
+            //gather the hydro variables at the corners and write the values of energy density to all corners of the hyperCube
+            if (dim == 4)
+            {
+              gatherHypercube<4>(corners, history, it0, it1, ix, iy, iz);
+              writeEnergyDensityToHypercube4D(hyperCube4D, corners);
+            }
+            else if (dim == 3)
+            {
+              gatherHypercube<3>(corners, history, it0, it1, ix, iy, iz);
+              writeEnergyDensityToHypercube3D(hyperCube3D, corners);
+            }
+            else if (dim == 2)
+            {
+              gatherHypercube<2>(corners, history, it0, it1, ix, iy, iz);
+              writeEnergyDensityToHypercube2D(hyperCube2D, corners);
+            }
+            else gatherHypercube<1>(corners, history, it0, it1, ix, iy, iz);
+
+            size_t p0 = (it - start) * ncells + ix + (size_t)nx * (iy + ny * iz);
+            for (int jc = 0; jc < ncorners; jc++) pointIds[jc] = pointIndex[p0 + cornerOffset[jc]];
+
+            //first the position of the cell
+            double cell_tau = t0 + ((double)(itOffset + it)) * dt; //check if this is the correct time!
+            double cell_x = (double)ix * dx  - (((double)(nx-1)) / 2.0 * dx);
+            double cell_y = (double)iy * dy  - (((double)(ny-1)) / 2.0 * dy);
+            double cell_z = (double)iz * dz  - (((double)(nz-1)) / 2.0 * dz);
+            const double cellPosition[3] = {cell_x, cell_y, cell_z};
+
+            for (int isurface = 0; isurface < nsurfaces; isurface++)
+            {
+              if (!(mask & (1 << isurface))) continue;
+              Cornelius &c = cor[isurface];
+              std::vector<double> &rows = tileRows[isurface];
+
+              for (int axis = 0; axis < dim; axis++)
+              {
+                int k = axis + 4 - dim;
+                int bit = 8 >> k;
+                const double * const cut = &edgeCuts[(isurface * dim + axis) * npoints];
+                for (int jc = 0; jc < ncorners; jc++)
+                  if (!(jc & bit)) cuts[16*k + jc] = cut[pointIds[jc]];
+              }
+
+              //use cornelius to find the centroid and normal vector of each hyperCube. In 0+1D the surface is the point
+              //where the time edge crosses the isotherm, with the normal towards the lower energy density
+              int nelements = 1;
+              if (dim == 4) c.find_surface_4d(hyperCube4D, cuts);
+              else if (dim == 3) c.find_surface_3d(hyperCube3D, cuts);
+              else if (dim == 2) c.find_surface_2d(hyperCube2D);
+              if (dim > 1) nelements = c.get_Nelements();
+              size_t row0 = rows.size();
+              rows.resize(row0 + nelements * FREEZEOUT_SURFACE_COLUMNS);
+              //write centroid and normal of each surface element to file
+              for (int i = 0; i < nelements; i++)
+              {
+                double * const element = &rows[row0 + i * FREEZEOUT_SURFACE_COLUMNS];
+                if (dim > 1)
+                {
+                  for (int k = 0; k < dim; k++)
+                  {
+                    centroid[k] = c.get_centroid_elem(i,k);
+                    normal[k] = c.get_normal_elem(i,k);
+                  }
+                }
+                else
+                {
+                  centroid[0] = cuts[16*3] * lattice_spacing[0];
+                  normal[0] = corners[FREEZEOUT_ENERGY_DENSITY] > corners[NUMBER_FREEZEOUT_VARIABLES + FREEZEOUT_ENERGY_DENSITY] ? 1.0 : -1.0;
+                }
+                double frac[4];
+                for (int k = 0; k < dim; k++) frac[k] = centroid[k] / lattice_spacing[k];
+
+                //the position of the centroid of surface element; along a degenerate axis that of the cell
+                if (writeCellTau) element[0] = cell_tau;
+                else element[0] = centroid[0] + cell_tau;
+                for (int axis = 0; axis < 3; axis++) element[1 + axis] = cellPosition[axis];
+                for (int k = 1; k < dim; k++) element[1 + axes[k-1]] = centroid[k] + cellPosition[axes[k-1]];
+                //then the (covariant?) surface normal element; check jacobian factors of tau for milne coordinates!
+                //acording to cornelius user guide, corenelius returns covariant components of normal vector without jacobian factors.
+                //the components along the degenerate axes are 0
+                element[4] = t * normal[0];
+                for (int axis = 0; axis < 3; axis++) element[5 + axis] = 0.0;
+                for (int k = 1; k < dim; k++) element[5 + axes[k-1]] = t * normal[k];
+                //all the necessary hydro dynamic variables, by linear interpolation from values at corners of hypercube:
+                //the contravariant flow velocity, the energy density, ten components of pi_(mu,nu) shear viscous tensor
+                //and the bulk pressure Pi. Note : iSpectra reads in file in fm^x units e.g. energy density should be in fm^-4
+                double values[NUMBER_FREEZEOUT_VARIABLES];
+                if (dim == 4) interpolateHypercube<4>(corners, frac, values);
+                else if (dim == 3) interpolateHypercube<3>(corners, frac, values);
+                else if (dim == 2) interpolateHypercube<2>(corners, frac, values);
+                else interpolateHypercube<1>(corners, frac, values);
+                for (int ivar = 0; ivar < 5; ivar++) element[8 + ivar] = values[ivar];
+                for (int ivar = 5; ivar < NUMBER_FREEZEOUT_VARIABLES; ivar++) element[10 + ivar] = values[ivar];
+              }
+            }
+          }
+
+          //the elements of the tile, coalesced, go to the surface files and the spectra
+          for (int isurface = 0; isurface < nsurfaces; isurface++)
+          {
+            std::vector<double> &rows = tileRows[isurface];
+            int nelements = rows.size() / FREEZEOUT_SURFACE_COLUMNS;
+            if (nelements == 0) continue;
+            foundElements += nelements;
+            if (coalesce) nelements = coalesceFreezeoutElements(rows.data(), nelements, coalescing, sums, first, count);
+            keptElements += nelements;
+            //the temperature !this needs to be checked, and the thermal pressure, for all elements of the tile at once
+            if ((int)eBatch.size() < nelements)
+            {
+              eBatch.resize(nelements);
+              TBatch.resize(nelements);
+              PBatch.resize(nelements);
+            }
+            for (int i = 0; i < nelements; i++) eBatch[i] = rows[i * FREEZEOUT_SURFACE_COLUMNS + 12];
+            equilibriumTemperatureAndPressure(eBatch.data(), TBatch.data(), PBatch.data(), nelements);
+            std::string &buffer = buffers[thread * nsurfaces + isurface];
+            for (int i = 0; i < nelements; i++)
+            {
+              double * const element = &rows[i * FREEZEOUT_SURFACE_COLUMNS];
+              element[13] = TBatch[i];
+              element[14] = PBatch[i];
+              if (surfaces) encodeFreezeoutElement(&surfaces[isurface], element, buffer);
+            }
+            if (spectra) addCooperFryeElements(&spectra[isurface], group, rows.data(), nelements);
+            blockElements[block * nsurfaces + isurface] += nelements;
+            rows.clear();
+          }
+        }
+        for (int isurface = 0; isurface < nsurfaces; isurface++)
+          blockEnd[block * nsurfaces + isurface] = buffers[thread * nsurfaces + isurface].size();
       }
     }
+
+    delete [] cor;
+    if (hyperCube4D) free4dArray(hyperCube4D, 2, 2, 2);
+    if (hyperCube3D) free3dArray(hyperCube3D, 2, 2);
+    if (hyperCube2D) free2dArray(hyperCube2D, 2);
+  }
+
+  //merge the blocks of each surface in order
+  for (int isurface = 0; isurface < nsurfaces && surfaces; isurface++)
+  {
+    for (int block = 0; block < nblocks; block++)
+    {
+      int b = block * nsurfaces + isurface;
+      writeFreezeoutElements(&surfaces[isurface], buffers[blockThread[block] * nsurfaces + isurface].data() + blockBegin[b],
+        blockEnd[b] - blockBegin[b], blockElements[b]);
+    }
+    flushFreezeoutSurfaceFile(&surfaces[isurface]);
+  }
+  //and the accumulators of the groups to the spectra in order
+  for (int isurface = 0; isurface < nsurfaces && spectra; isurface++) reduceCooperFryeSpectra(&spectra[isurface], ngroups);
+  history->foundElements += foundElements;
+  history->keptElements += keptElements;
+}
+
+//pipelined freezeout: the finder runs in a background thread, with its own OpenMP team, on one window of the history
+//while the hydro fills the next one. The ring then has 2*freezeoutFrequency+1 slots, so that the window being searched (freezeoutFrequency+1
+//slices) and the freezeoutFrequency new slices do not overlap. A window is handed off by its ring position alone, without a copy.
+//The hydro waits at a hand-off only if the previous window is still being searched, i.e. if the finder is more than
+//one window behind
+typedef struct
+{
+  int slot0, start, nit, itOffset;
+  double t;
+} FREEZEOUT_WINDOW;
+
+typedef struct
+{
+  pthread_t thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  int pending; //a window has been handed off and its search is not finished
+  int quit;
+  int nthreads; //size of the team of the finder
+  double waitTime; //time the hydro has spent waiting for the finder [s]
+  FREEZEOUT_WINDOW window;
+  //the arguments of findFreezeoutSurface that are the same for all windows
+  FREEZEOUT_HISTORY *history;
+  int dim, nsurfaces;
+  const double *freezeoutEnergyDensities;
+  double *lattice_spacing;
+  double t0, dt, dx, dy, dz;
+  int writeCellTau;
+  FREEZEOUT_SURFACE_FILE *surfaces;
+  COOPER_FRYE_SPECTRA *spectra;
+  const FREEZEOUT_COALESCING *coalescing;
+} FREEZEOUT_PIPELINE;
+
+void * freezeoutPipelineWorker(void *arg)
+{
+  FREEZEOUT_PIPELINE * const pipeline = (FREEZEOUT_PIPELINE *)arg;
+  omp_set_num_threads(pipeline->nthreads);
+  pthread_mutex_lock(&pipeline->mutex);
+  while (true)
+  {
+    while (!pipeline->pending && !pipeline->quit) pthread_cond_wait(&pipeline->cond, &pipeline->mutex);
+    if (!pipeline->pending) break;
+    FREEZEOUT_WINDOW w = pipeline->window;
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    findFreezeoutSurface(pipeline->history, w.slot0, w.start, w.nit, w.itOffset, pipeline->dim, pipeline->nsurfaces,
+      pipeline->freezeoutEnergyDensities, pipeline->lattice_spacing, w.t, pipeline->t0, pipeline->dt, pipeline->dx,
+      pipeline->dy, pipeline->dz, pipeline->writeCellTau, pipeline->surfaces, pipeline->spectra, pipeline->coalescing);
+
+    pthread_mutex_lock(&pipeline->mutex);
+    pipeline->pending = 0;
+    pthread_cond_broadcast(&pipeline->cond);
+  }
+  pthread_mutex_unlock(&pipeline->mutex);
+  return NULL;
+}
+
+void startFreezeoutPipeline(FREEZEOUT_PIPELINE * const pipeline, FREEZEOUT_HISTORY * const history, int dim,
+                            int nsurfaces, const double * const freezeoutEnergyDensities, double *lattice_spacing,
+                            double t0, double dt, double dx, double dy, double dz, int writeCellTau,
+                            FREEZEOUT_SURFACE_FILE * const surfaces, COOPER_FRYE_SPECTRA * const spectra,
+                            const FREEZEOUT_COALESCING * const coalescing, int nthreads)
+{
+  pipeline->history = history;
+  pipeline->dim = dim;
+  pipeline->nsurfaces = nsurfaces;
+  pipeline->freezeoutEnergyDensities = freezeoutEnergyDensities;
+  pipeline->lattice_spacing = lattice_spacing;
+  pipeline->t0 = t0;
+  pipeline->dt = dt;
+  pipeline->dx = dx;
+  pipeline->dy = dy;
+  pipeline->dz = dz;
+  pipeline->writeCellTau = writeCellTau;
+  pipeline->surfaces = surfaces;
+  pipeline->spectra = spectra;
+  pipeline->coalescing = coalescing;
+  pipeline->nthreads = nthreads;
+  pipeline->pending = 0;
+  pipeline->quit = 0;
+  pipeline->waitTime = 0;
+  pthread_mutex_init(&pipeline->mutex, NULL);
+  pthread_cond_init(&pipeline->cond, NULL);
+  if (pthread_create(&pipeline->thread, NULL, freezeoutPipelineWorker, pipeline) != 0)
+  {
+    printf("Could not start the freezeout thread!\n");
+    exit(-1);
   }
 }
-void writeEnergyDensityToHypercube4D(double ****hyperCube, double ****energy_density_evoution, int it, int ix, int iy, int iz)
-{
-  hyperCube[0][0][0][0] = energy_density_evoution[it][ix][iy][iz];
-  hyperCube[1][0][0][0] = energy_density_evoution[it+1][ix][iy][iz];
-  hyperCube[0][1][0][0] = energy_density_evoution[it][ix+1][iy][iz];
-  hyperCube[0][0][1][0] = energy_density_evoution[it][ix][iy+1][iz];
-  hyperCube[0][0][0][1] = energy_density_evoution[it][ix][iy][iz+1];
-  hyperCube[1][1][0][0] = energy_density_evoution[it+1][ix+1][iy][iz];
-  hyperCube[1][0][1][0] = energy_density_evoution[it+1][ix][iy+1][iz];
-  hyperCube[1][0][0][1] = energy_density_evoution[it+1][ix][iy][iz+1];
-  hyperCube[0][1][1][0] = energy_density_evoution[it][ix+1][iy+1][iz];
-  hyperCube[0][1][0][1] = energy_density_evoution[it][ix+1][iy][iz+1];
-  hyperCube[0][0][1][1] = energy_density_evoution[it][ix][iy+1][iz+1];
-  hyperCube[1][1][1][0] = energy_density_evoution[it+1][ix+1][iy+1][iz];
-  hyperCube[1][1][0][1] = energy_density_evoution[it+1][ix+1][iy][iz+1];
-  hyperCube[1][0][1][1] = energy_density_evoution[it+1][ix][iy+1][iz+1];
-  hyperCube[0][1][1][1] = energy_density_evoution[it][ix+1][iy+1][iz+1];
-  hyperCube[1][1][1][1] = energy_density_evoution[it+1][ix+1][iy+1][iz+1];
-}
-void writeEnergyDensityToHypercube3D(double ***hyperCube, double ****energy_density_evoution, int it, int ix, int iy)
-{
-  hyperCube[0][0][0] = energy_density_evoution[it][ix][iy][0];
-  hyperCube[1][0][0] = energy_density_evoution[it+1][ix][iy][0];
-  hyperCube[0][1][0] = energy_density_evoution[it][ix+1][iy][0];
-  hyperCube[0][0][1] = energy_density_evoution[it][ix][iy+1][0];
-  hyperCube[1][1][0] = energy_density_evoution[it+1][ix+1][iy][0];
-  hyperCube[1][0][1] = energy_density_evoution[it+1][ix][iy+1][0];
-  hyperCube[0][1][1] = energy_density_evoution[it][ix+1][iy+1][0];
-  hyperCube[1][1][1] = energy_density_evoution[it+1][ix+1][iy+1][0];
-}
-double interpolateVariable4D(double *****hydrodynamic_evoution, int ivar, int it, int ix, int iy, int iz, double tau_frac, double x_frac, double y_frac, double z_frac)
-{
-  double result = linearInterp4D(tau_frac, x_frac, y_frac, z_frac,
-    hydrodynamic_evoution[ivar][it][ix][iy][iz], hydrodynamic_evoution[ivar][it+1][ix][iy][iz], hydrodynamic_evoution[ivar][it][ix+1][iy][iz], hydrodynamic_evoution[ivar][it][ix][iy+1][iz], hydrodynamic_evoution[ivar][it][ix][iy][iz+1],
-    hydrodynamic_evoution[ivar][it+1][ix+1][iy][iz], hydrodynamic_evoution[ivar][it+1][ix][iy+1][iz], hydrodynamic_evoution[ivar][it+1][ix][iy][iz+1],
-    hydrodynamic_evoution[ivar][it][ix+1][iy+1][iz], hydrodynamic_evoution[ivar][it][ix+1][iy][iz+1], hydrodynamic_evoution[ivar][it][ix][iy+1][iz+1],
-    hydrodynamic_evoution[ivar][it+1][ix+1][iy+1][iz], hydrodynamic_evoution[ivar][it+1][ix+1][iy][iz+1], hydrodynamic_evoution[ivar][it][ix+1][iy+1][iz+1], hydrodynamic_evoution[ivar][it+1][ix][iy+1][iz+1], hydrodynamic_evoution[ivar][it+1][ix+1][iy+1][iz+1]);
-    return result;
-}
-
-double interpolateVariable3D(double *****hydrodynamic_evoution, int ivar, int it, int ix, int iy, double tau_frac, double x_frac, double y_frac)
-{
-  double result = linearInterp3D(tau_frac, x_frac, y_frac,
-    hydrodynamic_evoution[ivar][it][ix][iy][0], hydrodynamic_evoution[ivar][it+1][ix][iy][0], hydrodynamic_evoution[ivar][it][ix+1][iy][0], hydrodynamic_evoution[ivar][it][ix][iy+1][0],
-    hydrodynamic_evoution[ivar][it+1][ix+1][iy][0], hydrodynamic_evoution[ivar][it+1][ix][iy+1][0], hydrodynamic_evoution[ivar][it][ix+1][iy+1][0], hydrodynamic_evoution[ivar][it+1][ix+1][iy+1][0]);
-    return result;
+
+//hand off the window of slices start .. nit beginning at ring slot slot0 (see findFreezeoutSurface); waits for the
+//search of the previous window to finish, so that the slots the hydro overwrites next are no longer read
+void submitFreezeoutWindow(FREEZEOUT_PIPELINE * const pipeline, int slot0, int start, int nit, int itOffset, double t)
+{
+  double waitStart = omp_get_wtime();
+  pthread_mutex_lock(&pipeline->mutex);
+  while (pipeline->pending) pthread_cond_wait(&pipeline->cond, &pipeline->mutex);
+  pipeline->waitTime += omp_get_wtime() - waitStart;
+  pipeline->window.slot0 = slot0;
+  pipeline->window.start = start;
+  pipeline->window.nit = nit;
+  pipeline->window.itOffset = itOffset;
+  pipeline->window.t = t;
+  pipeline->pending = 1;
+  pthread_cond_broadcast(&pipeline->cond);
+  pthread_mutex_unlock(&pipeline->mutex);
+}
+
+//wait for the search of the window handed off last to finish, so that its elements are written
+void waitFreezeoutPipeline(FREEZEOUT_PIPELINE * const pipeline)
+{
+  double waitStart = omp_get_wtime();
+  pthread_mutex_lock(&pipeline->mutex);
+  while (pipeline->pending) pthread_cond_wait(&pipeline->cond, &pipeline->mutex);
+  pthread_mutex_unlock(&pipeline->mutex);
+  pipeline->waitTime += omp_get_wtime() - waitStart;
+}
+
+//search the last window handed off and stop the thread
+void finishFreezeoutPipeline(FREEZEOUT_PIPELINE * const pipeline)
+{
+  double waitStart = omp_get_wtime();
+  pthread_mutex_lock(&pipeline->mutex);
+  pipeline->quit = 1;
+  pthread_cond_broadcast(&pipeline->cond);
+  pthread_mutex_unlock(&pipeline->mutex);
+  pthread_join(pipeline->thread, NULL);
+  pipeline->waitTime += omp_get_wtime() - waitStart;
+  pthread_mutex_destroy(&pipeline->mutex);
+  pthread_cond_destroy(&pipeline->cond);
 }
@@ -19,6 +19,8 @@ FLUID_VELOCITY *u,*up,*uS;
 
 PRECISION *e, *p;
 
+PRECISION *rpi, *rPi;
+
 int columnMajorLinearIndex(int i, int j, int k, int nx, int ny) {
 	return i + nx * (j + ny * k);
 }
@@ -49,6 +51,9 @@ void allocateHostMemory(int len) {
 	uS->ux = (PRECISION *)calloc(len,bytes);
 	uS->uy = (PRECISION *)calloc(len,bytes);
 	uS->un = (PRECISION *)calloc(len,bytes);
+	// relaxation rates of the dissipative currents
+	rpi = (PRECISION *)calloc(len,bytes);
+	rPi = (PRECISION *)calloc(len,bytes);
 
 	//=======================================================
 	// Conserved variables
@@ -330,6 +335,8 @@ void freeHostMemory() {
 	free(u->ux);
 	free(u->uy);
 	free(u->un);
+	free(rpi);
+	free(rPi);
 
 	free(q->ttt);
 	free(q->ttx);
@@ -77,6 +77,8 @@ typedef struct
 extern CONSERVED_VARIABLES *q,*Q,*qS;
 extern FLUID_VELOCITY *u,*up,*uS,*uSS;
 extern PRECISION *e, *p;
+// relaxation rates 1/(u^\tau \tau_\pi) and 1/(u^\tau \tau_\Pi) at the beginning of the Runge-Kutta step
+extern PRECISION *rpi, *rPi;
 
 int columnMajorLinearIndex(int i, int j, int k, int nx, int ny);
 
@@ -14,6 +14,15 @@
 #include "../eos/EquationOfState.h"
  
 #define MAX_ITERS 10000000
+
+#ifndef IDEAL
+#define REGULATE_DISSIPATIVE_CURRENTS
+#endif
+//#define REGULATE_BULK //define to regulate bulk pressure according to inv reynolds #, otherwise bulk is not regulated
+
+REGULATION_COUNTERS regulationNaNs;
+CELL_REDUCTIONS cellReductions;
+PRECISION hotCellEnergyDensity;
 //const PRECISION ACC = 1e-2;
 
 PRECISION energyDensityFromConservedVariables(PRECISION ePrev, PRECISION M0, PRECISION M, PRECISION Pi) {
@@ -135,9 +144,83 @@ PRECISION * const __restrict__ ut, PRECISION * const __restrict__ ux, PRECISION
 	*un = M3 * E2;
 }
 
-void setInferredVariablesKernel(const CONSERVED_VARIABLES * const __restrict__ q, 
+/*
+ * Accumulates the cell reductions over the cells i = 2 .. ncx-3 of the row starting at s0, as a simd loop.
+ * Cells with e = NaN are counted and do not enter the min and max.
+ */
+inline void reduceRow(const CONSERVED_VARIABLES * const __restrict__ q,
+const PRECISION * const __restrict__ e, const PRECISION * const __restrict__ p, const FLUID_VELOCITY * const __restrict__ u,
+const PRECISION * const __restrict__ inverseSpacings, int s0, int ncx, PRECISION eHot,
+PRECISION &maxE, PRECISION &minE, long &hot, PRECISION &rate, PRECISION &energy, PRECISION &entropy, long &nanE
+) {
+	#pragma omp simd reduction(max:maxE,rate) reduction(min:minE) reduction(+:hot,energy,entropy,nanE)
+	for(int i = 2; i < ncx-2; ++i) {
+		int s = s0 + i;
+		PRECISION es = e[s];
+		PRECISION ut = u->ut[s];
+		maxE = es > maxE ? es : maxE;
+		minE = es < minE ? es : minE;
+		hot += es > eHot;
+		nanE += isnan(es);
+		// the spectral radii of the KT fluxes (see SpectralRadius.cpp) over the cell spacings
+		PRECISION rx = fabs(u->ux[s]/ut) * inverseSpacings[0];
+		PRECISION ry = fabs(u->uy[s]/ut) * inverseSpacings[1];
+		PRECISION rn = fabs(u->un[s]/ut) * inverseSpacings[2];
+		PRECISION r = rx > ry ? rx : ry;
+		r = r > rn ? r : rn;
+		rate = r > rate ? r : rate;
+		energy += q->ttt[s];
+		entropy += ut*(es+p[s])/effectiveTemperature(es);
+	}
+}
+
+static void setReductions(CELL_REDUCTIONS * const __restrict__ reductions, PRECISION t, void * latticeParams,
+PRECISION maxE, PRECISION minE, long hot, PRECISION rate, PRECISION energy, PRECISION entropy, long nanE
+) {
+	struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
+	PRECISION dV = t * lattice->latticeSpacingX * lattice->latticeSpacingY * lattice->latticeSpacingRapidity;
+	reductions->maxEnergyDensity = maxE;
+	reductions->minTemperature = effectiveTemperature(minE);
+	reductions->hotCells = hot;
+	reductions->maxSignalRate = rate;
+	reductions->totalEnergy = energy * dV;
+	reductions->totalEntropy = entropy * dV;
+	reductions->nanCells = nanE;
+}
+
+void setCellReductions(const CONSERVED_VARIABLES * const __restrict__ q,
+const PRECISION * const __restrict__ e, const PRECISION * const __restrict__ p, const FLUID_VELOCITY * const __restrict__ u,
+PRECISION t, void * latticeParams, CELL_REDUCTIONS * const __restrict__ reductions
+) {
+	struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
+
+	int ncx,ncy,ncz;
+	ncx = lattice->numComputationalLatticePointsX;
+	ncy = lattice->numComputationalLatticePointsY;
+	ncz = lattice->numComputationalLatticePointsRapidity;
+	const PRECISION inverseSpacings[3] = {1/lattice->latticeSpacingX, 1/lattice->latticeSpacingY,
+		1/lattice->latticeSpacingRapidity};
+
+	PRECISION maxE = -HUGE_VAL, minE = HUGE_VAL, rate = 0, energy = 0, entropy = 0;
+	long hot = 0, nanE = 0;
+	#pragma omp parallel for collapse(2) reduction(max:maxE,rate) reduction(min:minE) reduction(+:hot,energy,entropy,nanE)
+	for(int k = 2; k < ncz-2; ++k) {
+		for(int j = 2; j < ncy-2; ++j) {
+			reduceRow(q, e, p, u, inverseSpacings, columnMajorLinearIndex(0, j, k, ncx, ncy), ncx, hotCellEnergyDensity,
+				maxE, minE, hot, rate, energy, entropy, nanE);
+		}
+	}
+	setReductions(reductions, t, latticeParams, maxE, minE, hot, rate, energy, entropy, nanE);
+}
+
+/*
+ * Recovers (e,p,u) from the conserved variables and regulates the dissipative currents in the same sweep.
+ * Each (j,k) row is first recovered cell by cell (the root find does not vectorize), then reduced (if reductions
+ * is not NULL) and regulated by branch-free simd loops over the same row while it is still in cache.
+ */
+void setInferredVariablesKernel(CONSERVED_VARIABLES * const __restrict__ q, 
 PRECISION * const __restrict__ e, PRECISION * const __restrict__ p, FLUID_VELOCITY * const __restrict__ u, 
-PRECISION t, void * latticeParams
+PRECISION t, void * latticeParams, CELL_REDUCTIONS * const __restrict__ reductions
 ) {
 	struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
 
@@ -145,10 +228,18 @@ PRECISION t, void * latticeParams
 	ncx = lattice->numComputationalLatticePointsX;
 	ncy = lattice->numComputationalLatticePointsY;
 	ncz = lattice->numComputationalLatticePointsRapidity;
+	const PRECISION inverseSpacings[3] = {1/lattice->latticeSpacingX, 1/lattice->latticeSpacingY,
+		1/lattice->latticeSpacingRapidity};
 
-	for(int i = 2; i < ncx-2; ++i) {
+	long nanPipi = 0, nanSpipi = 0, nanA1 = 0, nanRho = 0, nanFac = 0, nanRhoBulk = 0, nanFacBulk = 0;
+	PRECISION maxE = -HUGE_VAL, minE = HUGE_VAL, rate = 0, energy = 0, entropy = 0;
+	long hot = 0, nanE = 0;
+
+	#pragma omp parallel for collapse(2) reduction(+:nanPipi,nanSpipi,nanA1,nanRho,nanFac,nanRhoBulk,nanFacBulk) \
+		reduction(max:maxE,rate) reduction(min:minE) reduction(+:hot,energy,entropy,nanE)
+	for(int k = 2; k < ncz-2; ++k) {
 		for(int j = 2; j < ncy-2; ++j) {
-			for(int k = 2; k < ncz-2; ++k) {
+			for(int i = 2; i < ncx-2; ++i) {
 				int s = columnMajorLinearIndex(i, j, k, ncx, ncy);
 
 				PRECISION q_s[NUMBER_CONSERVED_VARIABLES],_e,_p,ut,ux,uy,un;
@@ -181,8 +272,94 @@ PRECISION t, void * latticeParams
 				u->uy[s] = uy;
 				u->un[s] = un;
 			}
+			if (reductions) reduceRow(q, e, p, u, inverseSpacings, columnMajorLinearIndex(0, j, k, ncx, ncy), ncx, hotCellEnergyDensity,
+				maxE, minE, hot, rate, energy, entropy, nanE);
+#ifdef REGULATE_DISSIPATIVE_CURRENTS
+			PRECISION xi0 = (PRECISION)(1.0);
+			PRECISION rhomax = (PRECISION)(10.0);
+			PRECISION t2 = t*t;
+			#pragma omp simd reduction(+:nanPipi,nanSpipi,nanA1,nanRho,nanFac,nanRhoBulk,nanFacBulk)
+			for(int i = 2; i < ncx-2; ++i) {
+				int s = columnMajorLinearIndex(i, j, k, ncx, ncy);
+
+				PRECISION es = e[s];
+				PRECISION ps = p[s];
+				PRECISION eScale = sqrtf(es*es+3*ps*ps);
+#ifdef PIMUNU
+				PRECISION pitt = q->pitt[s];
+				PRECISION pitx = q->pitx[s];
+				PRECISION pity = q->pity[s];
+				PRECISION pitn = q->pitn[s];
+				PRECISION pixx = q->pixx[s];
+				PRECISION pixy = q->pixy[s];
+				PRECISION pixn = q->pixn[s];
+				PRECISION piyy = q->piyy[s];
+				PRECISION piyn = q->piyn[s];
+				PRECISION pinn = q->pinn[s];
+
+				PRECISION ut = u->ut[s];
+				PRECISION ux = u->ux[s];
+				PRECISION uy = u->uy[s];
+				PRECISION un = u->un[s];
+
+				PRECISION pipi = pitt*pitt-2*pitx*pitx-2*pity*pity+pixx*pixx+2*pixy*pixy+piyy*piyy-2*pitn*pitn*t2+2*pixn*pixn*t2+2*piyn*piyn*t2+pinn*pinn*t2*t2;
+				PRECISION spipi = sqrt(fabs(pipi));
+				PRECISION pimumu = pitt - pixx - piyy - pinn*t2;
+				PRECISION piu0 = -(pitn*t2*un) + pitt*ut - pitx*ux - pity*uy;
+				PRECISION piu1 = -(pixn*t2*un) + pitx*ut - pixx*ux - pixy*uy;
+				PRECISION piu2 = -(piyn*t2*un) + pity*ut - pixy*ux - piyy*uy;
+				PRECISION piu3 = -(pinn*t2*un) + pitn*ut - pixn*ux - piyn*uy;
+
+				PRECISION a1 = spipi/rhomax/eScale;
+				PRECISION a2 = pimumu/xi0/rhomax/spipi;
+				PRECISION a3 = piu0/xi0/rhomax/spipi;
+				PRECISION a4 = piu1/xi0/rhomax/spipi;
+				PRECISION a5 = piu2/xi0/rhomax/spipi;
+				PRECISION a6 = piu3/xi0/rhomax/spipi;
+				PRECISION rho = fmax(fmax(a1,a2),fmax(fmax(a3,a4),fmax(a5,a6)));
+				PRECISION fac = fabs(rho) < 1.e-7 ? (PRECISION)(1.0) : tanh(rho)/rho;
+
+				nanPipi += isnan(pipi);
+				nanSpipi += isnan(spipi);
+				nanA1 += isnan(a1);
+				nanRho += isnan(rho);
+				nanFac += isnan(fac);
+
+				q->pitt[s] = fac*pitt;
+				q->pitx[s] = fac*pitx;
+				q->pity[s] = fac*pity;
+				q->pitn[s] = fac*pitn;
+				q->pixx[s] = fac*pixx;
+				q->pixy[s] = fac*pixy;
+				q->pixn[s] = fac*pixn;
+				q->piyy[s] = fac*piyy;
+				q->piyn[s] = fac*piyn;
+				q->pinn[s] = fac*pinn;
+#endif
+				//regulate the bulk pressure according to it's inverse reynolds #
+#if defined REGULATE_BULK && defined PI
+				PRECISION Pi = q->Pi[s];
+				PRECISION rhoBulk = fabs(Pi) / eScale;
+				PRECISION facBulk = fabs(rhoBulk) < 1.e-7 ? (PRECISION)(1.0) : tanh(rhoBulk)/rhoBulk;
+
+				nanRhoBulk += isnan(rhoBulk);
+				nanFacBulk += isnan(facBulk);
+
+				q->Pi[s] = facBulk*Pi;
+#endif
+			}
+#endif
 		}
 	}
+
+	regulationNaNs.pipi += nanPipi;
+	regulationNaNs.spipi += nanSpipi;
+	regulationNaNs.a1 += nanA1;
+	regulationNaNs.rho += nanRho;
+	regulationNaNs.fac += nanFac;
+	regulationNaNs.rhoBulk += nanRhoBulk;
+	regulationNaNs.facBulk += nanFacBulk;
+	if (reductions) setReductions(reductions, t, latticeParams, maxE, minE, hot, rate, energy, entropy, nanE);
 }
 
 //===================================================================
@@ -15,9 +15,52 @@ PRECISION * const __restrict__ e, PRECISION * const __restrict__ p,
 PRECISION * const __restrict__ ut, PRECISION * const __restrict__ ux, PRECISION * const __restrict__ uy, PRECISION * const __restrict__ un
 );
 
-void setInferredVariablesKernel(const CONSERVED_VARIABLES * const __restrict__ q, 
+/*
+ * Number of cells in which an intermediate of the dissipative-current regulation came out NaN.
+ * Accumulated by setInferredVariablesKernel over the whole run instead of printing from the cell loop.
+ */
+typedef struct
+{
+	long pipi;
+	long spipi;
+	long a1;
+	long rho;
+	long fac;
+	long rhoBulk;
+	long facBulk;
+} REGULATION_COUNTERS;
+
+extern REGULATION_COUNTERS regulationNaNs;
+
+/*
+ * Reductions over the physical cells, computed by setInferredVariablesKernel as a by-product of the recovery of (e,p,u)
+ * at the end of a time step, and by setCellReductions for the initial conditions. They decide when the evolution ends
+ * and are printed for monitoring; maxSignalRate bounds the time step, dt <= CFL / maxSignalRate.
+ */
+typedef struct
+{
+	PRECISION maxEnergyDensity;
+	PRECISION minTemperature;	// of the coldest cell
+	long hotCells;				// cells with e > hotCellEnergyDensity
+	PRECISION maxSignalRate;	// largest spectral radius of the KT fluxes over the cell spacing,
+								// max(|u^x|/dx, |u^y|/dy, |u^\eta|/d\eta_s)/u^\tau [1/fm]
+	PRECISION totalEnergy;		// sum of \tau T^{\tau\tau} dx dy d\eta_s
+	PRECISION totalEntropy;		// sum of \tau u^\tau (e+p)/T dx dy d\eta_s
+	long nanCells;				// cells with e = NaN
+} CELL_REDUCTIONS;
+
+extern CELL_REDUCTIONS cellReductions;
+extern PRECISION hotCellEnergyDensity;
+
+// reductions is NULL if they are not needed (intermediate Runge-Kutta stages)
+void setInferredVariablesKernel(CONSERVED_VARIABLES * const __restrict__ q, 
 PRECISION * const __restrict__ e, PRECISION * const __restrict__ p, FLUID_VELOCITY * const __restrict__ u, 
-PRECISION t, void * latticeParams
+PRECISION t, void * latticeParams, CELL_REDUCTIONS * const __restrict__ reductions
+);
+
+void setCellReductions(const CONSERVED_VARIABLES * const __restrict__ q,
+const PRECISION * const __restrict__ e, const PRECISION * const __restrict__ p, const FLUID_VELOCITY * const __restrict__ u,
+PRECISION t, void * latticeParams, CELL_REDUCTIONS * const __restrict__ reductions
 );
 
 PRECISION Ttt(PRECISION e, PRECISION p, PRECISION ut, PRECISION pitt);
@@ -23,7 +23,6 @@
 #include "../util/FiniteDifference.h" //temp
 
 #include <omp.h>
-//#define REGULATE_BULK //define to regulate bulk pressure according to inv reynolds #, otherwise bulk is not regulated
 
 /**************************************************************************************************************************************************\
 void setNeighborCells(const PRECISION * const __restrict__ data,
@@ -149,12 +148,106 @@ int s, int ptr, int smm, int sm, int sp, int spp
 	*(out + ptr + 4) = in[spp];
 }
 
+inline void getConservedVariables(const CONSERVED_VARIABLES * const __restrict__ vars, int s, PRECISION * const __restrict__ Q) {
+	Q[0] = vars->ttt[s];
+	Q[1] = vars->ttx[s];
+	Q[2] = vars->tty[s];
+	Q[3] = vars->ttn[s];
+#ifdef PIMUNU
+	Q[4] = vars->pitt[s];
+	Q[5] = vars->pitx[s];
+	Q[6] = vars->pity[s];
+	Q[7] = vars->pitn[s];
+	Q[8] = vars->pixx[s];
+	Q[9] = vars->pixy[s];
+	Q[10] = vars->pixn[s];
+	Q[11] = vars->piyy[s];
+	Q[12] = vars->piyn[s];
+	Q[13] = vars->pinn[s];
+#endif
+#ifdef PI
+	Q[14] = vars->Pi[s];
+#endif
+}
+
+inline void putConservedVariables(CONSERVED_VARIABLES * const __restrict__ vars, int s, const PRECISION * const __restrict__ Q) {
+	vars->ttt[s] = Q[0];
+	vars->ttx[s] = Q[1];
+	vars->tty[s] = Q[2];
+	vars->ttn[s] = Q[3];
+#ifdef PIMUNU
+	vars->pitt[s] = Q[4];
+	vars->pitx[s] = Q[5];
+	vars->pity[s] = Q[6];
+	vars->pitn[s] = Q[7];
+	vars->pixx[s] = Q[8];
+	vars->pixy[s] = Q[9];
+	vars->pixn[s] = Q[10];
+	vars->piyy[s] = Q[11];
+	vars->piyn[s] = Q[12];
+	vars->pinn[s] = Q[13];
+#endif
+#ifdef PI
+	vars->Pi[s] = Q[14];
+#endif
+}
+
+// phi_1(z) = (1-e^{-z})/z and phi_2(z) = (e^{-z}-1+z)/z^2 of the exponential Runge-Kutta scheme
+inline PRECISION phi1(PRECISION z) {
+	if(z < 1.e-3) return 1 - z/2 + z*z/6;
+	return -expm1(-z)/z;
+}
+
+inline PRECISION phi2(PRECISION z) {
+	if(z < 1.e-3) return 0.5 - z/6 + z*z/24;
+	return (expm1(-z)+z)/(z*z);
+}
+
+// relaxation rate of each conserved variable: zero for T^{\tau\mu}, r[0] for \pi^{\mu\nu} and r[1] for \Pi
+inline void setRelaxationRates(const PRECISION * const __restrict__ r, PRECISION * const __restrict__ R) {
+	for (unsigned int n = 0; n < NUMBER_CONSERVATION_LAWS; ++n) R[n] = 0;
+#ifdef PIMUNU
+	for (unsigned int n = 4; n < 14; ++n) R[n] = r[0];
+#endif
+#ifdef PI
+	R[14] = r[1];
+#endif
+}
+
+// e^{-z}, phi_1(z) and phi_2(z) with z = dt*R for each conserved variable
+inline void setExponentialFactors(const PRECISION * const __restrict__ r, PRECISION dt,
+PRECISION * const __restrict__ E, PRECISION * const __restrict__ F1, PRECISION * const __restrict__ F2
+) {
+	PRECISION zpi = dt * r[0];
+	PRECISION zPi = dt * r[1];
+	PRECISION f[3][3] = {{1, 1, 0.5}, {exp(-zpi), phi1(zpi), phi2(zpi)}, {exp(-zPi), phi1(zPi), phi2(zPi)}};
+	for (unsigned int n = 0; n < NUMBER_CONSERVED_VARIABLES; ++n) {
+		int c = n < NUMBER_CONSERVATION_LAWS ? 0 : (n < 14 ? 1 : 2);
+		E[n] = f[c][0];
+		F1[n] = f[c][1];
+		F2[n] = f[c][2];
+	}
+}
+
+/**************************************************************************************************************************************************\
+ * The source kernels run after eulerStepKernelX/Y/Z, which leave dt*H (the flux and gradient terms) in updatedVars.
+ *
+ * With EXPONENTIAL_RELAXATION the stiff terms -R*q (R = 1/(u^\tau \tau_\pi) for \pi^{\mu\nu}, 1/(u^\tau \tau_\Pi) for \Pi, zero for T^{\tau\mu})
+ * are integrated exactly with the second order exponential time differencing scheme (ETD2RK) of Cox and Matthews:
+ *		qS = e^{-z} q + phi_1(z) dt N(q)								(eulerStepKernelSource)
+ *		Q = qS + phi_2(z) dt (N(qS) - N(q))						(exponentialRungeKuttaKernel)
+ * with z = dt*R evaluated at the beginning of the step and N = S + H the remaining terms. For R = 0 this is Heun's method.
+ * Without EXPONENTIAL_RELAXATION the relaxation terms are part of S and R = 0.
+/**************************************************************************************************************************************************/
 void eulerStepKernelSource(PRECISION t,
 const CONSERVED_VARIABLES * const __restrict__ currrentVars, CONSERVED_VARIABLES * const __restrict__ updatedVars,
 const PRECISION * const __restrict__ e, const PRECISION * const __restrict__ p,
 const FLUID_VELOCITY * const __restrict__ u, const FLUID_VELOCITY * const __restrict__ up,
-int ncx, int ncy, int ncz, PRECISION dt, PRECISION dx, PRECISION dy, PRECISION dz, PRECISION etabar
+int ncx, int ncy, int ncz, PRECISION dt, PRECISION dx, PRECISION dy, PRECISION dz
 ) {
+	PROPER_TIME_FACTORS tf;
+	setProperTimeFactors(&tf, t, dt);
+
 	//#pragma omp parallel for simd collapse(3)
 	#pragma omp parallel for collapse(3)
 	for(int i = 2; i < ncx-2; ++i) {
@@ -163,58 +256,85 @@ int ncx, int ncy, int ncz, PRECISION dt, PRECISION dx, PRECISION dy, PRECISION d
 				int s = columnMajorLinearIndex(i, j, k, ncx, ncy);
 				PRECISION Q[NUMBER_CONSERVED_VARIABLES];
 				PRECISION S[NUMBER_CONSERVED_VARIABLES];
+				PRECISION H[NUMBER_CONSERVED_VARIABLES];
+				PRECISION r[2];
 
-				Q[0] = currrentVars->ttt[s];
-				Q[1] = currrentVars->ttx[s];
-				Q[2] = currrentVars->tty[s];
-				Q[3] = currrentVars->ttn[s];
-#ifdef PIMUNU
-				Q[4] = currrentVars->pitt[s];
-				Q[5] = currrentVars->pitx[s];
-				Q[6] = currrentVars->pity[s];
-				Q[7] = currrentVars->pitn[s];
-				Q[8] = currrentVars->pixx[s];
-				Q[9] = currrentVars->pixy[s];
-				Q[10] = currrentVars->pixn[s];
-				Q[11] = currrentVars->piyy[s];
-				Q[12] = currrentVars->piyn[s];
-				Q[13] = currrentVars->pinn[s];
-#endif
-#ifdef PI
-				Q[14] = currrentVars->Pi[s];
-#endif
+				getConservedVariables(currrentVars, s, Q);
+				getConservedVariables(updatedVars, s, H);
 
-				loadSourceTerms2(Q, S, u, up->ut[s], up->ux[s], up->uy[s], up->un[s], t, e[s], p, s, ncx, ncy, ncz, etabar, dt, dx, dy, dz);
+				loadSourceTerms2(Q, S, r, u, up->ut[s], up->ux[s], up->uy[s], up->un[s], &tf, e[s], p, s, ncx, ncy, ncz, dx, dy, dz);
 
 				PRECISION result[NUMBER_CONSERVED_VARIABLES];
+#ifdef EXPONENTIAL_RELAXATION
+				PRECISION E[NUMBER_CONSERVED_VARIABLES], F1[NUMBER_CONSERVED_VARIABLES], F2[NUMBER_CONSERVED_VARIABLES];
+				setExponentialFactors(r, dt, E, F1, F2);
 				for (unsigned int n = 0; n < NUMBER_CONSERVED_VARIABLES; ++n) {
-					*(result+n) = *(Q+n) + dt * ( *(S+n) );
+					*(result+n) = *(E+n) * ( *(Q+n) ) + *(F1+n) * ( dt * ( *(S+n) ) + *(H+n) );
+				}
+				rpi[s] = r[0];
+				rPi[s] = r[1];
+#else
+				for (unsigned int n = 0; n < NUMBER_CONSERVED_VARIABLES; ++n) {
+					*(result+n) = *(Q+n) + dt * ( *(S+n) ) + *(H+n);
 				}
-
-				updatedVars->ttt[s] = result[0];
-				updatedVars->ttx[s] = result[1];
-				updatedVars->tty[s] = result[2];
-				updatedVars->ttn[s] = result[3];
-#ifdef PIMUNU
-				updatedVars->pitt[s] = result[4];
-				updatedVars->pitx[s] = result[5];
-				updatedVars->pity[s] = result[6];
-				updatedVars->pitn[s] = result[7];
-				updatedVars->pixx[s] = result[8];
-				updatedVars->pixy[s] = result[9];
-				updatedVars->pixn[s] = result[10];
-				updatedVars->piyy[s] = result[11];
-				updatedVars->piyn[s] = result[12];
-				updatedVars->pinn[s] = result[13];
-#endif
-#ifdef PI
-				updatedVars->Pi[s] = result[14];
 #endif
+				putConservedVariables(updatedVars, s, result);
 			}
 		}
 	}
 }
 
+#ifdef EXPONENTIAL_RELAXATION
+void exponentialRungeKuttaKernel(PRECISION t,
+const CONSERVED_VARIABLES * const __restrict__ q, const CONSERVED_VARIABLES * const __restrict__ currrentVars,
+CONSERVED_VARIABLES * const __restrict__ updatedVars,
+const PRECISION * const __restrict__ e, const PRECISION * const __restrict__ p,
+const FLUID_VELOCITY * const __restrict__ u, const FLUID_VELOCITY * const __restrict__ up,
+int ncx, int ncy, int ncz, PRECISION dt, PRECISION dx, PRECISION dy, PRECISION dz
+) {
+	PROPER_TIME_FACTORS tf;
+	setProperTimeFactors(&tf, t, dt);
+
+	//#pragma omp parallel for simd collapse(3)
+	#pragma omp parallel for collapse(3)
+	for(int i = 2; i < ncx-2; ++i) {
+		for(int j = 2; j < ncy-2; ++j) {
+			for(int k = 2; k < ncz-2; ++k) {
+				int s = columnMajorLinearIndex(i, j, k, ncx, ncy);
+				PRECISION q0[NUMBER_CONSERVED_VARIABLES];
+				PRECISION Q[NUMBER_CONSERVED_VARIABLES];
+				PRECISION S[NUMBER_CONSERVED_VARIABLES];
+				PRECISION H[NUMBER_CONSERVED_VARIABLES];
+				PRECISION r[2];
+
+				getConservedVariables(q, s, q0);
+				getConservedVariables(currrentVars, s, Q);
+				getConservedVariables(updatedVars, s, H);
+
+				loadSourceTerms2(Q, S, r, u, up->ut[s], up->ux[s], up->uy[s], up->un[s], &tf, e[s], p, s, ncx, ncy, ncz, dx, dy, dz);
+
+				// the linear part is frozen at the rates of the first stage, the difference is treated explicitly
+				PRECISION r0[2] = {rpi[s], rPi[s]};
+				PRECISION R[NUMBER_CONSERVED_VARIABLES], R0[NUMBER_CONSERVED_VARIABLES];
+				setRelaxationRates(r, R);
+				setRelaxationRates(r0, R0);
+				PRECISION E[NUMBER_CONSERVED_VARIABLES], F1[NUMBER_CONSERVED_VARIABLES], F2[NUMBER_CONSERVED_VARIABLES];
+				setExponentialFactors(r0, dt, E, F1, F2);
+
+				PRECISION result[NUMBER_CONSERVED_VARIABLES];
+				for (unsigned int n = 0; n < NUMBER_CONSERVED_VARIABLES; ++n) {
+					// dt*N at the intermediate and at the initial state
+					PRECISION N1 = dt * ( *(S+n) + ( *(R0+n) - *(R+n) ) * ( *(Q+n) ) ) + *(H+n);
+					PRECISION N0 = ( *(Q+n) - *(E+n) * ( *(q0+n) ) ) / ( *(F1+n) );
+					*(result+n) = *(Q+n) + *(F2+n) * (N1 - N0);
+				}
+				putConservedVariables(updatedVars, s, result);
+			}
+		}
+	}
+}
+#endif
+
 void eulerStepKernelX(PRECISION t,
 const CONSERVED_VARIABLES * const __restrict__ currrentVars, CONSERVED_VARIABLES * const __restrict__ updatedVars,
 const FLUID_VELOCITY * const __restrict__ u, const PRECISION * const __restrict__ e,
@@ -281,24 +401,24 @@ int ncx, int ncy, int ncz, PRECISION dt, PRECISION dx
 					*(result+n) *= dt;
 				}
 
-				updatedVars->ttt[s] += result[0];
-				updatedVars->ttx[s] += result[1];
-				updatedVars->tty[s] += result[2];
-				updatedVars->ttn[s] += result[3];
+				updatedVars->ttt[s] = result[0];
+				updatedVars->ttx[s] = result[1];
+				updatedVars->tty[s] = result[2];
+				updatedVars->ttn[s] = result[3];
 #ifdef PIMUNU
-				updatedVars->pitt[s] += result[4];
-				updatedVars->pitx[s] += result[5];
-				updatedVars->pity[s] += result[6];
-				updatedVars->pitn[s] += result[7];
-				updatedVars->pixx[s] += result[8];
-				updatedVars->pixy[s] += result[9];
-				updatedVars->pixn[s] += result[10];
-				updatedVars->piyy[s] += result[11];
-				updatedVars->piyn[s] += result[12];
-				updatedVars->pinn[s] += result[13];
+				updatedVars->pitt[s] = result[4];
+				updatedVars->pitx[s] = result[5];
+				updatedVars->pity[s] = result[6];
+				updatedVars->pitn[s] = result[7];
+				updatedVars->pixx[s] = result[8];
+				updatedVars->pixy[s] = result[9];
+				updatedVars->pixn[s] = result[10];
+				updatedVars->piyy[s] = result[11];
+				updatedVars->piyn[s] = result[12];
+				updatedVars->pinn[s] = result[13];
 #endif
 #ifdef PI
-				updatedVars->Pi[s] += result[14];
+				updatedVars->Pi[s] = result[14];
 #endif
 			}
 		}
@@ -537,135 +657,11 @@ int ncx, int ncy, int ncz
 }
 
 /**************************************************************************************************************************************************/
-#ifndef IDEAL
-void
-regulateDissipativeCurrents(PRECISION t,
-const CONSERVED_VARIABLES * const __restrict__ currentVars,
-const PRECISION * const __restrict__ e, const PRECISION * const __restrict__ p,
-const FLUID_VELOCITY * const __restrict__ u,
-int ncx, int ncy, int ncz
-) {
-	//#pragma omp parallel for simd collapse(3)
-	#pragma omp parallel for collapse(3)
-	for(int i = 2; i < ncx-2; ++i) {
-		for(int j = 2; j < ncy-2; ++j) {
-			for(int k = 2; k < ncz-2; ++k) {
-				int s = columnMajorLinearIndex(i, j, k, ncx, ncy);
-
-#ifdef PIMUNU
-				PRECISION pitt = currentVars->pitt[s];
-				PRECISION pitx = currentVars->pitx[s];
-				PRECISION pity = currentVars->pity[s];
-				PRECISION pitn = currentVars->pitn[s];
-				PRECISION pixx = currentVars->pixx[s];
-				PRECISION pixy = currentVars->pixy[s];
-				PRECISION pixn = currentVars->pixn[s];
-				PRECISION piyy = currentVars->piyy[s];
-				PRECISION piyn = currentVars->piyn[s];
-				PRECISION pinn = currentVars->pinn[s];
-#else
-				PRECISION pitt = 0.0;
-				PRECISION pitx = 0.0;
-				PRECISION pity = 0.0;
-				PRECISION pitn = 0.0;
-				PRECISION pixx = 0.0;
-				PRECISION pixy = 0.0;
-				PRECISION pixn = 0.0;
-				PRECISION piyy = 0.0;
-				PRECISION piyn = 0.0;
-				PRECISION pinn = 0.0;
-#endif
-#ifdef PI
-				PRECISION Pi = currentVars->Pi[s];
-#else
-				PRECISION Pi = 0;
-#endif
-
-				PRECISION ut = u->ut[s];
-				PRECISION ux = u->ux[s];
-				PRECISION uy = u->uy[s];
-				PRECISION un = u->un[s];
-
-				PRECISION xi0 = (PRECISION)(1.0);
-				PRECISION rhomax = (PRECISION)(10.0);
-				//PRECISION xi0 = (PRECISION)(0.1);
-				//PRECISION rhomax = (PRECISION)(0.8);
-				PRECISION t2 = t*t;
-		//		PRECISION pipi = pitt*pitt-2*(pitx*pitx+pity*pity-pixy*pixy+t2*(pitn*pitn-pixn*pixn-piyn*piyn))+pixx*pixx+piyy*piyy+pinn*pinn*t2*t2;
-				PRECISION pipi = pitt*pitt-2*pitx*pitx-2*pity*pity+pixx*pixx+2*pixy*pixy+piyy*piyy-2*pitn*pitn*t2+2*pixn*pixn*t2+2*piyn*piyn*t2+pinn*pinn*t2*t2;
-				if(isnan(pipi)==1) printf("found pipi Nan\n");
-				//PRECISION spipi = sqrt(fabs(pipi+3*Pi*Pi)); //change this to sqrt(fabs(pipi)) to remove bulk pressure regulation of shear stress
-				PRECISION spipi = sqrt(fabs(pipi)); //change this to sqrt(fabs(pipi)) to remove bulk pressure regulation of shear stress
-				if(isnan(spipi)==1) printf("found spipi Nan\n");
-				PRECISION pimumu = pitt - pixx - piyy - pinn*t*t;
-				PRECISION piu0 = -(pitn*t2*un) + pitt*ut - pitx*ux - pity*uy;
-				PRECISION piu1 = -(pixn*t2*un) + pitx*ut - pixx*ux - pixy*uy;
-				PRECISION piu2 = -(piyn*t2*un) + pity*ut - pixy*ux - piyy*uy;
-				PRECISION piu3 = -(pinn*t2*un) + pitn*ut - pixn*ux - piyn*uy;
-
-				PRECISION a1 = spipi/rhomax/sqrtf(e[s]*e[s]+3*p[s]*p[s]);
-				if(isnan(a1)==1) printf("found a1 Nan\n");
-				PRECISION a2 = pimumu/xi0/rhomax/spipi;
-				PRECISION a3 = piu0/xi0/rhomax/spipi;
-				PRECISION a4 = piu1/xi0/rhomax/spipi;
-				PRECISION a5 = piu2/xi0/rhomax/spipi;
-				PRECISION a6 = piu3/xi0/rhomax/spipi;
-				PRECISION a12 = fmax(a1,a2);
-				PRECISION a34 = fmax(a3,a4);
-				PRECISION a56 = fmax(a5,a6);
-				PRECISION a3456 = fmax(a34,a56);
-				PRECISION rho = fmax(a12,a3456);
-
-				if(isnan(rho)==1) printf("found rho Nan\n");
-				PRECISION fac = tanh(rho)/rho;
-				if(fabs(rho)<1.e-7) fac = 1;
-				if(isnan(fac)==1) printf("found fac Nan\n");
-
-				//regulate the shear stress
-				#ifdef PIMUNU
-				currentVars->pitt[s] *= fac;
-				currentVars->pitx[s] *= fac;
-				currentVars->pity[s] *= fac;
-				currentVars->pitn[s] *= fac;
-				currentVars->pixx[s] *= fac;
-				currentVars->pixy[s] *= fac;
-				currentVars->pixn[s] *= fac;
-				currentVars->piyy[s] *= fac;
-				currentVars->piyn[s] *= fac;
-				currentVars->pinn[s] *= fac;
-				#endif
-
-				//regulate the bulk pressure according to it's inverse reynolds #
-				#ifdef REGULATE_BULK
-				PRECISION rhoBulk = abs(Pi) / sqrtf(e[s]*e[s]+3*p[s]*p[s]);
-				if(isnan(rhoBulk) == 1) printf("found rhoBulk Nan\n");
-                                PRECISION facBulk = tanh(rhoBulk) / rhoBulk;
-                                if(fabs(rhoBulk) < 1.e-7) facBulk = 1.0;
-                                if(isnan(facBulk) == 1) printf("found facBulk Nan\n");
-
-				//regulate bulk pressure
-				#ifdef PI
-				currentVars->Pi[s] *= facBulk;
-				#endif
-
-				#endif
-
-			}
-		}
-	}
-}
-#endif
-/**************************************************************************************************************************************************/
-#ifndef IDEAL
-#define REGULATE_DISSIPATIVE_CURRENTS
-#endif
-
 void
 rungeKutta2(PRECISION t, PRECISION dt, CONSERVED_VARIABLES * __restrict__ q, CONSERVED_VARIABLES * __restrict__ Q,
 void * latticeParams, void * hydroParams
 ) {
 	struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
-	struct HydroParameters * hydro = (struct HydroParameters *) hydroParams;
 
 	int nx = lattice->numLatticePointsX;
 	int ny = lattice->numLatticePointsY;
@@ -678,42 +674,36 @@ void * latticeParams, void * hydroParams
 	PRECISION dy = (PRECISION)(lattice->latticeSpacingY);
 	PRECISION dz = (PRECISION)(lattice->latticeSpacingRapidity);
 
-	PRECISION etabar = (PRECISION)(hydro->shearViscosityToEntropyDensity);
-
 	//===================================================
 	// STEP 1:
 	//===================================================
-	eulerStepKernelSource(t, q, qS, e, p, u, up, ncx, ncy, ncz, dt, dx, dy, dz, etabar);
 	eulerStepKernelX(t, q, qS, u, e, ncx, ncy, ncz, dt, dx);
 	eulerStepKernelY(t, q, qS, u, e, ncx, ncy, ncz, dt, dy);
 	eulerStepKernelZ(t, q, qS, u, e, ncx, ncy, ncz, dt, dz);
+	eulerStepKernelSource(t, q, qS, e, p, u, up, ncx, ncy, ncz, dt, dx, dy, dz);
 
 	t+=dt;
 
-	setInferredVariablesKernel(qS, e, p, uS, t, latticeParams);
-
-#ifdef REGULATE_DISSIPATIVE_CURRENTS
-	regulateDissipativeCurrents(t, qS, e, p, uS, ncx, ncy, ncz);
-#endif
+	setInferredVariablesKernel(qS, e, p, uS, t, latticeParams, NULL);
 
 	setGhostCells(qS, e, p, uS, latticeParams);
 
 	//===================================================
 	// STEP 2:
 	//===================================================
-	eulerStepKernelSource(t, qS, Q, e, p, uS, u, ncx, ncy, ncz, dt, dx, dy, dz, etabar);
 	eulerStepKernelX(t, qS, Q, uS, e, ncx, ncy, ncz, dt, dx);
 	eulerStepKernelY(t, qS, Q, uS, e, ncx, ncy, ncz, dt, dy);
 	eulerStepKernelZ(t, qS, Q, uS, e, ncx, ncy, ncz, dt, dz);
+#ifdef EXPONENTIAL_RELAXATION
+	exponentialRungeKuttaKernel(t, q, qS, Q, e, p, uS, u, ncx, ncy, ncz, dt, dx, dy, dz);
+#else
+	eulerStepKernelSource(t, qS, Q, e, p, uS, u, ncx, ncy, ncz, dt, dx, dy, dz);
 
 	convexCombinationEulerStepKernel(q, Q, ncx, ncy, ncz);
+#endif
 
 	swapFluidVelocity(&up, &u);
-	setInferredVariablesKernel(Q, e, p, u, t, latticeParams);
-
-#ifdef REGULATE_DISSIPATIVE_CURRENTS
-	regulateDissipativeCurrents(t, Q, e, p, u, ncx, ncy, ncz);
-#endif
+	setInferredVariablesKernel(Q, e, p, u, t, latticeParams, &cellReductions);
 
 	setGhostCells(Q, e, p, u, latticeParams);
 }
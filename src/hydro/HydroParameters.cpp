@@ -10,8 +10,19 @@
 
 double initialProperTimePoint;
 double shearViscosityToEntropyDensity;
+double shearViscositySlopeGeV;
+double shearViscosityKinkTemperatureGeV;
+int bulkViscosityProfile;
+double bulkViscosityMax;
+double bulkViscosityPeakTemperatureGeV;
+double bulkViscosityWidthGeV;
 double freezeoutTemperatureGeV;
+int numberOfFreezeoutTemperatures;
+double freezeoutTemperaturesGeV[MAX_FREEZEOUT_TEMPERATURES];
 int initializePimunuNavierStokes;
+int freezeoutCoalescingCells;
+double freezeoutCoalescingNormalTolerance;
+double freezeoutCoalescingFieldTolerance;
 
 void loadHydroParameters(config_t *cfg, const char* configDirectory, void * params) {
 	// Read the file
@@ -24,13 +35,38 @@ void loadHydroParameters(config_t *cfg, const char* configDirectory, void * para
 
 	getDoubleProperty(cfg, "initialProperTimePoint", &initialProperTimePoint, 0.1);
 	getDoubleProperty(cfg, "shearViscosityToEntropyDensity", &shearViscosityToEntropyDensity, 0.0795775);
+	getDoubleProperty(cfg, "shearViscositySlopeGeV", &shearViscositySlopeGeV, 0.0);
+	getDoubleProperty(cfg, "shearViscosityKinkTemperatureGeV", &shearViscosityKinkTemperatureGeV, 0.154);
+	getDoubleProperty(cfg, "bulkViscosityMax", &bulkViscosityMax, 0.05);
+	getDoubleProperty(cfg, "bulkViscosityPeakTemperatureGeV", &bulkViscosityPeakTemperatureGeV, 0.18);
+	getDoubleProperty(cfg, "bulkViscosityWidthGeV", &bulkViscosityWidthGeV, 0.02);
 	getDoubleProperty(cfg, "freezeoutTemperatureGeV", &freezeoutTemperatureGeV, 0.155);
+	numberOfFreezeoutTemperatures = getDoubleArrayProperty(cfg, "freezeoutTemperaturesGeV", freezeoutTemperaturesGeV, MAX_FREEZEOUT_TEMPERATURES);
+	if(numberOfFreezeoutTemperatures == 0) {
+		numberOfFreezeoutTemperatures = 1;
+		freezeoutTemperaturesGeV[0] = freezeoutTemperatureGeV;
+	}
 
+	getIntegerProperty(cfg, "bulkViscosityProfile", &bulkViscosityProfile, 0);
 	getIntegerProperty(cfg, "initializePimunuNavierStokes", &initializePimunuNavierStokes, 1);
+	getIntegerProperty(cfg, "freezeoutCoalescingCells", &freezeoutCoalescingCells, 0);
+	getDoubleProperty(cfg, "freezeoutCoalescingNormalTolerance", &freezeoutCoalescingNormalTolerance, 1e-3);
+	getDoubleProperty(cfg, "freezeoutCoalescingFieldTolerance", &freezeoutCoalescingFieldTolerance, 1e-2);
 
 	struct HydroParameters * hydro = (struct HydroParameters *) params;
 	hydro->initialProperTimePoint = initialProperTimePoint;
 	hydro->shearViscosityToEntropyDensity = shearViscosityToEntropyDensity;
+	hydro->shearViscositySlopeGeV = shearViscositySlopeGeV;
+	hydro->shearViscosityKinkTemperatureGeV = shearViscosityKinkTemperatureGeV;
+	hydro->bulkViscosityProfile = bulkViscosityProfile;
+	hydro->bulkViscosityMax = bulkViscosityMax;
+	hydro->bulkViscosityPeakTemperatureGeV = bulkViscosityPeakTemperatureGeV;
+	hydro->bulkViscosityWidthGeV = bulkViscosityWidthGeV;
 	hydro->freezeoutTemperatureGeV = freezeoutTemperatureGeV;
+	hydro->numberOfFreezeoutTemperatures = numberOfFreezeoutTemperatures;
+	for(int i = 0; i < numberOfFreezeoutTemperatures; ++i) hydro->freezeoutTemperaturesGeV[i] = freezeoutTemperaturesGeV[i];
 	hydro->initializePimunuNavierStokes = initializePimunuNavierStokes;
+	hydro->freezeoutCoalescingCells = freezeoutCoalescingCells;
+	hydro->freezeoutCoalescingNormalTolerance = freezeoutCoalescingNormalTolerance;
+	hydro->freezeoutCoalescingFieldTolerance = freezeoutCoalescingFieldTolerance;
 }
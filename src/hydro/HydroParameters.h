@@ -12,12 +12,27 @@
 
 #include "../hydro/DynamicalVariables.h"
 
+#define MAX_FREEZEOUT_TEMPERATURES 8
+
 struct HydroParameters
 {
 	double initialProperTimePoint;
 	double shearViscosityToEntropyDensity;
+	double shearViscositySlopeGeV;
+	double shearViscosityKinkTemperatureGeV;
+	int bulkViscosityProfile;
+	double bulkViscosityMax;
+	double bulkViscosityPeakTemperatureGeV;
+	double bulkViscosityWidthGeV;
 	double freezeoutTemperatureGeV;
+	// isotherms extracted in the same run; {freezeoutTemperatureGeV} unless freezeoutTemperaturesGeV is set
+	int numberOfFreezeoutTemperatures;
+	double freezeoutTemperaturesGeV[MAX_FREEZEOUT_TEMPERATURES];
 	int initializePimunuNavierStokes;
+	// merging of nearly coplanar freezeout surface elements of neighbouring cells, see FREEZEOUT_COALESCING in freezeout.h
+	int freezeoutCoalescingCells;
+	double freezeoutCoalescingNormalTolerance;
+	double freezeoutCoalescingFieldTolerance;
 };
 
 void loadHydroParameters(config_t *cfg, const char* configDirectory, void * params);
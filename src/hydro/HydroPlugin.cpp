@@ -7,61 +7,182 @@
 
 #include <stdlib.h>
 #include <stdio.h> // for printf
+#include <string.h>
+#include <stdint.h>
 
 // for timing
 #include <ctime>
 #include <iostream>
 
 //for cornelius and writing freezeout file
-#include <fstream>
-#include "../freezeout/cornelius-c++-1.3/cornelius.cpp"
-#include "../freezeout/freezeout.h"
 #include "../freezeout/memory.h"
+#include "../freezeout/freezeout.h"
 
 #include "../hydro/HydroPlugin.h"
 #include "../hydro/DynamicalVariables.h"
 #include "../lattice/LatticeParameters.h"
 #include "../ic/InitialConditionParameters.h"
 #include "../hydro/HydroParameters.h"
+#include "../freezeout/SpectraParameters.h"
 #include "../io/FileIO.h"
+#include "../io/SnapshotFile.h"
+#include "../io/OutputParameters.h"
+#include "../io/OutputFields.h"
+#include "../io/CheckpointFile.h"
 #include "../ic/InitialConditions.h"
 #include "../hydro/FullyDiscreteKurganovTadmorScheme.h"
 #include "../hydro/EnergyMomentumTensor.h"
+#include "../hydro/TransportCoefficients.h"
 #include "../eos/EquationOfState.h"
 
-#define FREQ 10 //write output to file every FREQ timesteps
-#define FOFREQ 10 //call freezeout surface finder every FOFREQ timesteps
-#define FOTEST 0 //if true, freezeout surface file is written with proper times rounded (down) to step size
-#define FOFORMAT 0 // 0 : write f.o. surface to ASCII file ;  1 : write to binary file
+//the output plan (output.properties) sets what is written, the freezeout finder frequency and the file formats
+#define FOPIPELINE 1 //if true, the freezeout finder runs in a background thread while the hydro evolves the next freezeoutFrequency steps
 
-void outputDynamicalQuantities(double t, const char *outputDir, void * latticeParams)
+//the fields of the output plan that are due at time t are evaluated into a staging buffer and written by the output
+//thread while the hydro evolves; the others are not computed at all
+void outputDynamicalQuantities(double t, double dt, int n, const struct OutputParameters * const output, const int * const fields,
+  double * const nextOutputTimes, void * latticeParams, SNAPSHOT_WRITER * const snapshotWriter)
 {
-  output(e, t, outputDir, "e", latticeParams);
-  output(u->ux, t, outputDir, "ux", latticeParams);
-  output(u->uy, t, outputDir, "uy", latticeParams);
-  //	output(u->un, t, outputDir, "un", latticeParams);
-  output(u->ut, t, outputDir, "ut", latticeParams);
-  //	output(q->ttt, t, outputDir, "ttt", latticeParams);
-  //	output(q->ttn, t, outputDir, "ttn", latticeParams);
-  #ifdef PIMUNU
-  //output(q->pixx, t, outputDir, "pixx", latticeParams);
-  //output(q->pixy, t, outputDir, "pixy", latticeParams);
-  //output(q->pixn, t, outputDir, "pixn", latticeParams);
-  //output(q->piyy, t, outputDir, "piyy", latticeParams);
-  //output(q->piyn, t, outputDir, "piyn", latticeParams);
-  //output(q->pinn, t, outputDir, "pinn", latticeParams);
-  #endif
-  #ifdef PI
-  //output(q->Pi, t, outputDir, "Pi", latticeParams);
-  #endif
+  uint64_t mask = 0;
+  for (int f = 0; f < output->numberOfFields; f++)
+  {
+    if (output->intervals[f] > 0)
+    {
+      if (t < nextOutputTimes[f] - 0.5*dt) continue;
+      while (nextOutputTimes[f] <= t + 0.5*dt) nextOutputTimes[f] += output->intervals[f];
+    }
+    else if ((n-1) % output->outputFrequency != 0) continue;
+    mask |= (uint64_t)1 << f;
+  }
+  if (!mask) return;
+  PRECISION *values = acquireSnapshotBuffer(snapshotWriter);
+  const size_t ncells = snapshotCells(&snapshotWriter->file);
+  for (int f = 0; f < output->numberOfFields; f++)
+  {
+    if (!(mask & ((uint64_t)1 << f))) continue;
+    //the velocity of the previous step is not known at the initial time
+    evaluateOutputField(fields[f], &snapshotWriter->file, latticeParams, t, n > 1 ? dt : 0, values);
+    values += ncells;
+  }
+  queueSnapshot(snapshotWriter, t, mask);
+}
+
+//the configuration of a run that a checkpoint can be resumed with: the lattice, the time steps, the freezeout
+//finder and the output files, which the resumed run continues. The transport coefficients can be changed, e.g. to
+//branch studies from a saved state
+typedef struct
+{
+  int ncx, ncy, ncz;
+  double dx, dy, dz, t0, dt;
+  int freezeoutFrequency, nslots, nsurfaces;
+  double freezeoutEnergyDensities[MAX_FREEZEOUT_TEMPERATURES];
+  int writeFreezeoutSurface, freezeoutFormat, cooperFrye;
+  int outputFormat, numberOfFields;
+  char fields[MAX_OUTPUT_FIELDS][MAX_OUTPUT_FIELD_NAME_LENGTH];
+  int snapshotCells[3];
+} HYDRO_CHECKPOINT_CONFIGURATION;
+
+//the name of the first member in which the configurations differ, or NULL if they are the same; compared member
+//by member, since the padding between them is not part of the configuration
+static const char * differentCheckpointConfiguration(const HYDRO_CHECKPOINT_CONFIGURATION *a,
+  const HYDRO_CHECKPOINT_CONFIGURATION *b)
+{
+#define CHECKPOINT_CONFIGURATION_DIFFERS(member) if (a->member != b->member) return #member
+  CHECKPOINT_CONFIGURATION_DIFFERS(ncx);
+  CHECKPOINT_CONFIGURATION_DIFFERS(ncy);
+  CHECKPOINT_CONFIGURATION_DIFFERS(ncz);
+  CHECKPOINT_CONFIGURATION_DIFFERS(dx);
+  CHECKPOINT_CONFIGURATION_DIFFERS(dy);
+  CHECKPOINT_CONFIGURATION_DIFFERS(dz);
+  CHECKPOINT_CONFIGURATION_DIFFERS(t0);
+  CHECKPOINT_CONFIGURATION_DIFFERS(dt);
+  CHECKPOINT_CONFIGURATION_DIFFERS(freezeoutFrequency);
+  CHECKPOINT_CONFIGURATION_DIFFERS(nslots);
+  CHECKPOINT_CONFIGURATION_DIFFERS(nsurfaces);
+  for (int k = 0; k < a->nsurfaces; k++) CHECKPOINT_CONFIGURATION_DIFFERS(freezeoutEnergyDensities[k]);
+  CHECKPOINT_CONFIGURATION_DIFFERS(writeFreezeoutSurface);
+  CHECKPOINT_CONFIGURATION_DIFFERS(freezeoutFormat);
+  CHECKPOINT_CONFIGURATION_DIFFERS(cooperFrye);
+  CHECKPOINT_CONFIGURATION_DIFFERS(outputFormat);
+  CHECKPOINT_CONFIGURATION_DIFFERS(numberOfFields);
+  for (int f = 0; f < a->numberOfFields; f++)
+    if (strncmp(a->fields[f], b->fields[f], MAX_OUTPUT_FIELD_NAME_LENGTH)) return "fields";
+  for (int i = 0; i < 3; i++) CHECKPOINT_CONFIGURATION_DIFFERS(snapshotCells[i]);
+#undef CHECKPOINT_CONFIGURATION_DIFFERS
+  return NULL;
+}
 
+//the state of a run at the beginning of time step n that is not in the arrays of the lattice, of the freezeout
+//history and of the spectra, which are the other blocks of a checkpoint (see hydroCheckpointBlocks)
+typedef struct
+{
+  HYDRO_CHECKPOINT_CONFIGURATION configuration;
+  //the time loop
+  int n;
+  double t;
+  int accumulator2, nsteps;
+  double totalTime;
+  CELL_REDUCTIONS cellReductions;
+  REGULATION_COUNTERS regulationNaNs;
+  double nextOutputTimes[MAX_OUTPUT_FIELDS];
+  //the output files, which are cut off at these sizes when the run is resumed
+  long snapshotOffset, numberOfSnapshots;
+  long surfaceOffsets[MAX_FREEZEOUT_TEMPERATURES], surfaceElements[MAX_FREEZEOUT_TEMPERATURES];
+  //the freezeout history
+  int lastStep;
+  long capturedCells, capturedSteps, lateStoredCells, foundElements, keptElements;
+} HYDRO_CHECKPOINT;
+
+//the blocks of a checkpoint (see CheckpointFile.h): the header, the sizes of the records of the slots of the freezeout
+//history, the lattice arrays with the ghost cells, of this step and of the previous one as far as the hydro keeps
+//them, the freezeout history and the spectra
+static void hydroCheckpointBlocks(HYDRO_CHECKPOINT * const header, uint64_t * const recordSizes, int nElements,
+  FREEZEOUT_HISTORY * const history, COOPER_FRYE_SPECTRA * const spectra, int nsurfaces, std::vector<void *> &data,
+  std::vector<size_t> &sizes)
+{
+  const size_t bytes = nElements * sizeof(PRECISION);
+  data.push_back(header); sizes.push_back(sizeof(HYDRO_CHECKPOINT));
+  data.push_back(recordSizes); sizes.push_back(3 * history->nslots * sizeof(uint64_t));
+  //the structs of the variables are their arrays one after the other
+  CONSERVED_VARIABLES * const variables[2] = {q, Q};
+  for (int v = 0; v < 2; v++)
+  {
+    PRECISION ** const conserved = (PRECISION **)variables[v];
+    for (size_t k = 0; k < sizeof(CONSERVED_VARIABLES) / sizeof(PRECISION *); k++)
+    {
+      data.push_back(conserved[k]); sizes.push_back(bytes);
+    }
+  }
+  FLUID_VELOCITY * const velocities[2] = {u, up};
+  for (int v = 0; v < 2; v++)
+  {
+    PRECISION ** const velocity = (PRECISION **)velocities[v];
+    for (size_t k = 0; k < sizeof(FLUID_VELOCITY) / sizeof(PRECISION *); k++)
+    {
+      data.push_back(velocity[k]); sizes.push_back(bytes);
+    }
+  }
+  data.push_back(e); sizes.push_back(bytes);
+  data.push_back(p); sizes.push_back(bytes);
+  freezeoutHistoryBlocks(history, data, sizes);
+  for (int k = 0; k < nsurfaces && spectra; k++)
+  {
+    data.push_back(spectra[k].spectra); sizes.push_back(spectra[k].size * sizeof(double));
+    data.push_back(&spectra[k].numberOfElements); sizes.push_back(sizeof(long));
+  }
 }
 
-void run(void * latticeParams, void * initCondParams, void * hydroParams, const char *rootDirectory, const char *outputDir)
+void run(void * latticeParams, void * initCondParams, void * hydroParams, void * spectraParams, void * outputParams,
+  const char *rootDirectory, const char *outputDir, const char *restartFile)
 {
   struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
   struct InitialConditionParameters * initCond = (struct InitialConditionParameters *) initCondParams;
   struct HydroParameters * hydro = (struct HydroParameters *) hydroParams;
+  struct SpectraParameters * spectra = (struct SpectraParameters *) spectraParams;
+  struct OutputParameters * output = (struct OutputParameters *) outputParams;
+  const int outputFrequency = output->outputFrequency;
+  const int freezeoutFrequency = output->freezeoutFrequency;
+  const int checkpointFrequency = output->checkpointFrequency;
 
   /************************************************************************************	\
   * System configuration
@@ -83,78 +204,195 @@ void run(void * latticeParams, void * initCondParams, void * hydroParams, const
   double dz = lattice->latticeSpacingRapidity;
   double e0 = initCond->initialEnergyDensity;
 
-  double freezeoutTemperatureGeV = hydro->freezeoutTemperatureGeV;
+  //one freezeout surface is extracted for each isotherm; the hydro runs until all cells are below the lowest one
   const double hbarc = 0.197326938;
-  const double freezeoutTemperature = freezeoutTemperatureGeV/hbarc;
-  //const double freezeoutEnergyDensity = e0*pow(freezeoutTemperature,4);
-  const double freezeoutEnergyDensity = equilibriumEnergyDensity(freezeoutTemperature);
+  int nFreezeout = hydro->numberOfFreezeoutTemperatures;
+  double freezeoutEnergyDensities[MAX_FREEZEOUT_TEMPERATURES];
+  double freezeoutEnergyDensity = 0;
   printf("Grid size = %d x %d x %d\n", nx, ny, nz);
   printf("spatial resolution = (%.3f, %.3f, %.3f)\n", lattice->latticeSpacingX, lattice->latticeSpacingY, lattice->latticeSpacingRapidity);
-  printf("freezeout temperature = %.3f [fm^-1] (eF = %.3f [fm^-4])\n", freezeoutTemperature, freezeoutEnergyDensity);
+  for (int k = 0; k < nFreezeout; k++)
+  {
+    const double freezeoutTemperature = hydro->freezeoutTemperaturesGeV[k]/hbarc;
+    //freezeoutEnergyDensities[k] = e0*pow(freezeoutTemperature,4);
+    freezeoutEnergyDensities[k] = equilibriumEnergyDensity(freezeoutTemperature);
+    if (k == 0 || freezeoutEnergyDensities[k] < freezeoutEnergyDensity) freezeoutEnergyDensity = freezeoutEnergyDensities[k];
+    printf("freezeout temperature = %.3f [fm^-1] (eF = %.3f [fm^-4])\n", freezeoutTemperature, freezeoutEnergyDensities[k]);
+  }
 
   // allocate memory
   allocateHostMemory(nElements);
 
-  //initialize cornelius for freezeout surface finding
+  //set up freezeout surface finding (each thread of the finder initializes its own cornelius)
   //see example_4d() in example_cornelius
-  //this works only for full 3+1 d simulation? need to find a way to generalize to n+1 d
-  int dim;
-  double *lattice_spacing;
-  if ((nx > 1) && (ny > 1) && (nz > 1))
+  //the hypercubes are spanned by the time axis and the spatial axes with more than one lattice point, e.g. t, x, eta
+  //for a 2+1D run in the x-eta plane, so the finder searches 2^dim corners per cell (dim = 1 for 0+1D)
+  int freezeoutAxes[3];
+  int dim = 1 + freezeoutSpatialAxes(nx, ny, nz, freezeoutAxes);
+  double *lattice_spacing = new double[dim];
+  const double spatialLatticeSpacings[3] = {dx, dy, dz};
+  lattice_spacing[0] = dt;
+  for (int k = 1; k < dim; k++) lattice_spacing[k] = spatialLatticeSpacings[freezeoutAxes[k-1]];
+  printf("freezeout surface finder in %d+1D\n", dim - 1);
+
+  //store the energy density, and all the hydrodynamic variables near the freezeout surfaces, for freezeoutFrequency+1 time steps, to be written to file
+  //once the freezeout surface is determined by the critical energy density
+  //the temperature and pressure are calclated with EoS
+  //the background finder searches one window while the next freezeoutFrequency steps are stored, so it needs freezeoutFrequency more slots
+  FREEZEOUT_HISTORY history;
+  allocateFreezeoutHistory(&history, FOPIPELINE ? 2*freezeoutFrequency+1 : freezeoutFrequency+1, nx, ny, nz, dim, nFreezeout,
+    freezeoutEnergyDensities);
+
+  //the fields of the output plan are written by an output thread, in binary to one file per run or per output time
+  //unless outputFormat is 0
+  const char *outputFieldNames[MAX_OUTPUT_FIELDS];
+  for (int f = 0; f < output->numberOfFields; f++) outputFieldNames[f] = output->fields[f];
+  SNAPSHOT_FILE snapshotFile;
+  initializeSnapshotFile(&snapshotFile, latticeParams, output->numberOfFields, outputFieldNames, output->xRange, output->yRange,
+    output->rapidityRange, output->decimation);
+
+  //the state of the run is written to a checkpoint every checkpointFrequency steps, from which a run started with
+  //--restart resumes: it continues the output files of the checkpointed run, in its output directory, and reproduces
+  //it bit for bit with any number of threads, since the spectra are summed in a fixed order (see CooperFrye.h)
+  HYDRO_CHECKPOINT_CONFIGURATION configuration;
+  memset(&configuration, 0, sizeof(configuration));
+  configuration.ncx = ncx;
+  configuration.ncy = ncy;
+  configuration.ncz = ncz;
+  configuration.dx = dx;
+  configuration.dy = dy;
+  configuration.dz = dz;
+  configuration.t0 = t0;
+  configuration.dt = dt;
+  configuration.freezeoutFrequency = freezeoutFrequency;
+  configuration.nslots = history.nslots;
+  configuration.nsurfaces = nFreezeout;
+  for (int k = 0; k < nFreezeout; k++) configuration.freezeoutEnergyDensities[k] = freezeoutEnergyDensities[k];
+  configuration.writeFreezeoutSurface = spectra->writeFreezeoutSurface;
+  configuration.freezeoutFormat = output->freezeoutFormat;
+  configuration.cooperFrye = spectra->cooperFrye;
+  configuration.outputFormat = output->outputFormat;
+  configuration.numberOfFields = output->numberOfFields;
+  for (int f = 0; f < output->numberOfFields; f++) strncpy(configuration.fields[f], output->fields[f], MAX_OUTPUT_FIELD_NAME_LENGTH);
+  configuration.snapshotCells[0] = snapshotFile.nx;
+  configuration.snapshotCells[1] = snapshotFile.ny;
+  configuration.snapshotCells[2] = snapshotFile.nz;
+  char checkpointPath[255];
+  sprintf(checkpointPath, "%s/checkpoint.bin", outputDir);
+  HYDRO_CHECKPOINT checkpoint;
+  memset(&checkpoint, 0, sizeof(checkpoint));
+  CHECKPOINT_FILE restart;
+  if (restartFile)
   {
-    dim = 4;
-    lattice_spacing = new double[dim];
-    lattice_spacing[0] = dt;
-    lattice_spacing[1] = dx;
-    lattice_spacing[2] = dy;
-    lattice_spacing[3] = dz;
+    openCheckpointFile(&restart, restartFile);
+    readCheckpointBlock(&restart, 0, &checkpoint, sizeof(checkpoint));
+    const char *member = differentCheckpointConfiguration(&checkpoint.configuration, &configuration);
+    if (member)
+    {
+      printf("The checkpoint %s was written by a run with a different lattice, time step, freezeout finder or output plan:"
+        " %s differs!\n", restartFile, member);
+      exit(-1);
+    }
   }
-  else if ((nx > 1) && (ny > 1) && (nz < 2))
+
+  //open the freezeout surface file (see FreezeoutSurfaceFile.h for the formats)
+  FREEZEOUT_SURFACE_FILE freezeoutSurfaceFiles[MAX_FREEZEOUT_TEMPERATURES];
+  char freezeoutSurfacePaths[MAX_FREEZEOUT_TEMPERATURES][255];
+  FREEZEOUT_SURFACE_FILE *surfaces = spectra->writeFreezeoutSurface ? freezeoutSurfaceFiles : NULL;
+  for (int k = 0; k < nFreezeout && surfaces; k++)
   {
-    dim = 3;
-    lattice_spacing = new double[dim];
-    lattice_spacing[0] = dt;
-    lattice_spacing[1] = dx;
-    lattice_spacing[2] = dy;
+    freezeoutSurfaceFilePath(freezeoutSurfacePaths[k], outputDir, output->freezeoutFormat, nFreezeout, hydro->freezeoutTemperaturesGeV[k]);
+    if (restartFile)
+      resumeFreezeoutSurfaceFile(&freezeoutSurfaceFiles[k], freezeoutSurfacePaths[k], output->freezeoutFormat, dim,
+        checkpoint.surfaceOffsets[k], checkpoint.surfaceElements[k]);
+    else
+      openFreezeoutSurfaceFile(&freezeoutSurfaceFiles[k], freezeoutSurfacePaths[k], output->freezeoutFormat, dim);
   }
-  else
+  //the hadron spectra of each isotherm are evaluated from the surface elements as they are found (see CooperFrye.h)
+  COOPER_FRYE_SPECTRA cooperFryeSpectra[MAX_FREEZEOUT_TEMPERATURES];
+  COOPER_FRYE_SPECTRA *particleSpectra = spectra->cooperFrye ? cooperFryeSpectra : NULL;
+  for (int k = 0; k < nFreezeout && particleSpectra; k++) initializeCooperFryeSpectra(&cooperFryeSpectra[k], spectraParams);
+  //nearly coplanar elements of neighbouring cells are merged (see FREEZEOUT_COALESCING)
+  FREEZEOUT_COALESCING coalescing;
+  coalescing.cells = hydro->freezeoutCoalescingCells;
+  coalescing.normalTolerance = hydro->freezeoutCoalescingNormalTolerance;
+  coalescing.fieldTolerance = hydro->freezeoutCoalescingFieldTolerance;
+  //the fields of the output plan
+  int outputFields[MAX_OUTPUT_FIELDS];
+  double nextOutputTimes[MAX_OUTPUT_FIELDS];
+  for (int f = 0; f < output->numberOfFields; f++)
   {
-    printf("simulation is not in 3+1D or 2+1D; freezeout finder will not work!\n");
+    outputFields[f] = outputFieldIndex(output->fields[f]);
+    if (outputFields[f] < 0)
+    {
+      printf("Unknown output field %s (see OutputFields.h)!\n", output->fields[f]);
+      exit(-1);
+    }
+    nextOutputTimes[f] = restartFile ? checkpoint.nextOutputTimes[f] : t0;
   }
-
-  Cornelius cor;
-  cor.init(dim, freezeoutEnergyDensity, lattice_spacing);
-
-  double ****energy_density_evoution;
-  energy_density_evoution = calloc4dArray(energy_density_evoution, FOFREQ+1, nx, ny, nz);
-
-  //make an array to store all the hydrodynamic variables for FOFREQ time steps
-  //to be written to file once the freezeout surface is determined by the critical energy density
-  int n_hydro_vars = 16; //u0, u1, u2, u3, e, pi00, pi01, pi02, pi03, pi11, pi12, pi13, pi22, pi23, pi33, Pi, the temperature and pressure are calclated with EoS
-  double *****hydrodynamic_evoution;
-  hydrodynamic_evoution = calloc5dArray(hydrodynamic_evoution, n_hydro_vars, FOFREQ+1, nx, ny, nz);
-
-  //for 3+1D simulations
-  double ****hyperCube4D;
-  hyperCube4D = calloc4dArray(hyperCube4D, 2, 2, 2, 2);
-  //for 2+1D simulations
-  double ***hyperCube3D;
-  hyperCube3D = calloc3dArray(hyperCube3D, 2, 2, 2);
-
-  //open the freezeout surface file
-  ofstream freezeoutSurfaceFile;
-  if (FOFORMAT == 0) freezeoutSurfaceFile.open("output/surface.dat");
-  else freezeoutSurfaceFile.open("output/surface.dat", ios::binary);
+  printf("output of %d x %d x %d cells of %d fields\n", snapshotFile.nx, snapshotFile.ny, snapshotFile.nz, output->numberOfFields);
+  SNAPSHOT_WRITER snapshotWriter;
+  if (restartFile)
+    resumeSnapshotWriter(&snapshotWriter, &snapshotFile, output->outputFormat, outputDir, t0, output->outputBuffers,
+      checkpoint.snapshotOffset, checkpoint.numberOfSnapshots);
+  else
+    startSnapshotWriter(&snapshotWriter, &snapshotFile, output->outputFormat, outputDir, t0, output->outputBuffers);
+  #if FOPIPELINE
+  //the threads are split between the teams of the hydro and of the background finder (freezeoutThreadFraction)
+  const int numberOfThreads = omp_get_max_threads();
+  int freezeoutThreads = (int)(output->freezeoutThreadFraction * numberOfThreads + 0.5);
+  if (freezeoutThreads > numberOfThreads - 1) freezeoutThreads = numberOfThreads - 1;
+  if (freezeoutThreads < 1) freezeoutThreads = 1;
+  const int hydroThreads = numberOfThreads > 1 ? numberOfThreads - freezeoutThreads : 1;
+  omp_set_num_threads(hydroThreads);
+  printf("%d threads evolve the hydro and %d search the freezeout surface\n", hydroThreads, freezeoutThreads);
+  FREEZEOUT_PIPELINE freezeoutPipeline;
+  startFreezeoutPipeline(&freezeoutPipeline, &history, dim, nFreezeout, freezeoutEnergyDensities, lattice_spacing,
+    t0, dt, dx, dy, dz, output->freezeoutCellTime, surfaces, particleSpectra, &coalescing, freezeoutThreads);
+  #endif
   /************************************************************************************	\
   * Fluid dynamic initialization
   /************************************************************************************/
   double t = t0;
-  // generate initial conditions
-  setInitialConditions(latticeParams, initCondParams, hydroParams, rootDirectory);
-  // Calculate conserved quantities
-  setConservedVariables(t, latticeParams);
-  // impose boundary conditions with ghost cells
-  setGhostCells(q,e,p,u,latticeParams);
+  int n0 = 1;
+  initializeTransportCoefficients(hydroParams);
+  // the reductions over the cells are updated by each time step; the evolution ends when no cell is hotter than the
+  // lowest freezeout energy density
+  hotCellEnergyDensity = freezeoutEnergyDensity;
+  if (restartFile)
+  {
+    // the arrays are copied from the mapped checkpoint, once the records of the freezeout history have the sizes of
+    // the checkpointed run
+    std::vector<uint64_t> recordSizes(3 * history.nslots);
+    readCheckpointBlock(&restart, 1, recordSizes.data(), recordSizes.size() * sizeof(uint64_t));
+    resizeFreezeoutHistoryRecords(&history, recordSizes.data());
+    std::vector<void *> blocks;
+    std::vector<size_t> blockSizes;
+    hydroCheckpointBlocks(&checkpoint, recordSizes.data(), nElements, &history, particleSpectra, nFreezeout, blocks, blockSizes);
+    for (size_t b = 2; b < blocks.size(); b++) readCheckpointBlock(&restart, b, blocks[b], blockSizes[b]);
+    closeCheckpointFile(&restart);
+    n0 = checkpoint.n;
+    t = checkpoint.t;
+    cellReductions = checkpoint.cellReductions;
+    regulationNaNs = checkpoint.regulationNaNs;
+    history.lastStep = checkpoint.lastStep;
+    history.capturedCells = checkpoint.capturedCells;
+    history.capturedSteps = checkpoint.capturedSteps;
+    history.lateStoredCells = checkpoint.lateStoredCells;
+    history.foundElements = checkpoint.foundElements;
+    history.keptElements = checkpoint.keptElements;
+    printf("resumed from the checkpoint %s at n = %d (t = %.3f)\n", restartFile, n0 - 1, t);
+  }
+  else
+  {
+    // generate initial conditions
+    setInitialConditions(latticeParams, initCondParams, hydroParams, rootDirectory);
+    // Calculate conserved quantities
+    setConservedVariables(t, latticeParams);
+    // impose boundary conditions with ghost cells
+    setGhostCells(q,e,p,u,latticeParams);
+    setCellReductions(q, e, p, u, t, latticeParams, &cellReductions);
+  }
 
   /************************************************************************************	\
   * Evolve the system in time
@@ -166,19 +404,58 @@ void run(void * latticeParams, void * initCondParams, void * hydroParams, const
 
   std::clock_t t1,t2;
 
-  double totalTime = 0;
-  int nsteps = 0;
+  double totalTime = restartFile ? checkpoint.totalTime : 0;
+  int nsteps = restartFile ? checkpoint.nsteps : 0;
 
-  int accumulator1 = 0;
-  int accumulator2 = 0;
+  int accumulator2 = restartFile ? checkpoint.accumulator2 : 0;
   // evolve in time
-  for (int n = 1; n <= nt+1; ++n)
+  for (int n = n0; n <= nt+1; ++n)
   {
-    // copy variables back to host and write to disk
-    if ((n-1) % FREQ == 0) {
-      printf("n = %d:%d (t = %.3f),\t (e, p) = (%.3f, %.3f) [fm^-4],\t (T = %.3f [GeV]),\t",
-      n - 1, nt, t, e[sctr], p[sctr], effectiveTemperature(e[sctr])*hbarc);
-      outputDynamicalQuantities(t, outputDir, latticeParams);
+    // write a checkpoint of the state at the beginning of the step, once what the previous steps found and output is
+    // in the files
+    if (checkpointFrequency > 0 && n > n0 && (n-1) % checkpointFrequency == 0)
+    {
+      #if FOPIPELINE
+      waitFreezeoutPipeline(&freezeoutPipeline);
+      #endif
+      checkpoint.configuration = configuration;
+      checkpoint.n = n;
+      checkpoint.t = t;
+      checkpoint.accumulator2 = accumulator2;
+      checkpoint.nsteps = nsteps;
+      checkpoint.totalTime = totalTime;
+      checkpoint.cellReductions = cellReductions;
+      checkpoint.regulationNaNs = regulationNaNs;
+      for (int f = 0; f < output->numberOfFields; f++) checkpoint.nextOutputTimes[f] = nextOutputTimes[f];
+      checkpoint.snapshotOffset = snapshotWriterOffset(&snapshotWriter);
+      checkpoint.numberOfSnapshots = snapshotWriter.file.numberOfSnapshots;
+      for (int k = 0; k < nFreezeout && surfaces; k++)
+      {
+        checkpoint.surfaceOffsets[k] = freezeoutSurfaceFileOffset(&freezeoutSurfaceFiles[k]);
+        checkpoint.surfaceElements[k] = freezeoutSurfaceFiles[k].numberOfElements;
+      }
+      checkpoint.lastStep = history.lastStep;
+      checkpoint.capturedCells = history.capturedCells;
+      checkpoint.capturedSteps = history.capturedSteps;
+      checkpoint.lateStoredCells = history.lateStoredCells;
+      checkpoint.foundElements = history.foundElements;
+      checkpoint.keptElements = history.keptElements;
+      std::vector<uint64_t> recordSizes(3 * history.nslots);
+      freezeoutHistoryRecordSizes(&history, recordSizes.data());
+      std::vector<void *> blocks;
+      std::vector<size_t> blockSizes;
+      hydroCheckpointBlocks(&checkpoint, recordSizes.data(), nElements, &history, particleSpectra, nFreezeout, blocks, blockSizes);
+      writeCheckpointFile(checkpointPath, blocks.size(), blocks.data(), blockSizes.data());
+      printf("checkpoint of n = %d (t = %.3f) written to %s\n", n - 1, t, checkpointPath);
+    }
+
+    // write the fields of the output plan that are due
+    outputDynamicalQuantities(t, dt, n, output, outputFields, nextOutputTimes, latticeParams, &snapshotWriter);
+    if ((n-1) % outputFrequency == 0) {
+      printf("n = %d:%d (t = %.3f),\t (e, p) = (%.3f, %.3f) [fm^-4],\t (T = %.3f [GeV]),\t e_max = %.3f [fm^-4],\t (E, S) = (%.3f, %.3f),\t",
+      n - 1, nt, t, e[sctr], p[sctr], effectiveTemperature(e[sctr])*hbarc, cellReductions.maxEnergyDensity,
+      cellReductions.totalEnergy, cellReductions.totalEntropy);
+      if (cellReductions.nanCells) printf("%ld cells with e = NaN,\t", cellReductions.nanCells);
       // end hydrodynamic simulation if the temperature is below the freezeout temperature
       //if(e[sctr] < freezeoutEnergyDensity) {
       //printf("\nReached freezeout temperature at the center.\n");
@@ -192,234 +469,34 @@ void run(void * latticeParams, void * initCondParams, void * hydroParams, const
     // be read by iS3D : https://github.com/derekeverett/iS3D
     //************************************************************************************/
 
-    //append the energy density and all hydro variables to storage arrays
-    int nFO = n % FOFREQ;
-
-    if(nFO == 0) //swap in the old values so that freezeout volume elements have overlap between calls to finder
-    {
-      swapAndSetHydroVariables(energy_density_evoution, hydrodynamic_evoution, q, e, u, nx, ny, nz, FOFREQ);
-    }
-    else //update the values of the rest of the array with current time step
-    {
-      setHydroVariables(energy_density_evoution, hydrodynamic_evoution, q, e, u, nx, ny, nz, FOFREQ, n);
-    }
+    //append the energy density and all hydro variables to the ring of time slices
+    //the last slice searched by one call to the finder is the first slice of the next call
+    int nFO = n % freezeoutFrequency;
+    setHydroVariables(&history, q, e, u, Q, up, n);
 
     //the n=1 values are written to the it = 2 index of array, so don't start until here
     int start;
-    if (n <= FOFREQ) start = 2;
-    //if (n <= FOFREQ) start = 1;
+    if (n <= freezeoutFrequency) start = 2;
+    //if (n <= freezeoutFrequency) start = 1;
     else start = 0;
-    if (nFO == FOFREQ - 1) //call the freezeout finder should this be put before the values are set?
+    if (nFO == freezeoutFrequency - 1) //call the freezeout finder should this be put before the values are set?
     {
-
       //besides writing centroid and normal to file, write all the hydro variables
-      int dimZ;
-      if (dim == 4) dimZ = nz-1; //enter the loop over iz, and avoid problems at boundary
-      else if (dim == 3) dimZ = 1; //we need to enter the 'loop' over iz rather than skipping it
-      for (int it = start; it < FOFREQ; it++) //note* avoiding boundary problems (reading outside array)
-      {
-        for (int ix = 0; ix < nx-1; ix++)
-        {
-          for (int iy = 0; iy < ny-1; iy++)
-          {
-            for (int iz = 0; iz < dimZ; iz++)
-            {
-              //write the values of energy density to all corners of the hyperCube
-              if (dim == 4) writeEnergyDensityToHypercube4D(hyperCube4D, energy_density_evoution, it, ix, iy, iz);
-              else if (dim == 3) writeEnergyDensityToHypercube3D(hyperCube3D, energy_density_evoution, it, ix, iy);
-
-              //use cornelius to find the centroid and normal vector of each hyperCube
-              if (dim == 4) cor.find_surface_4d(hyperCube4D);
-              else if (dim == 3) cor.find_surface_3d(hyperCube3D);
-              //write centroid and normal of each surface element to file
-              for (int i = 0; i < cor.get_Nelements(); i++)
-              {
-                double temp = 0.0; //temporary variable
-                //first write the position of the centroid of surface element
-                double cell_tau;
-                if (n <= FOFREQ) cell_tau = t0 + ( (double)(n - FOFREQ + (it-1) ) )* dt; //check if this is the correct time!
-                else cell_tau = t0 + ((double)(n - FOFREQ + it)) * dt; //check if this is the correct time!
-                double cell_x = (double)ix * dx  - (((double)(nx-1)) / 2.0 * dx);
-                double cell_y = (double)iy * dy  - (((double)(ny-1)) / 2.0 * dy);
-                double cell_z = (double)iz * dz  - (((double)(nz-1)) / 2.0 * dz);
-
-                double tau_frac = cor.get_centroid_elem(i,0) / lattice_spacing[0];
-                double x_frac = cor.get_centroid_elem(i,1) / lattice_spacing[1];
-                double y_frac = cor.get_centroid_elem(i,2) / lattice_spacing[2];
-                double z_frac;
-                if (dim == 4) z_frac = cor.get_centroid_elem(i,3) / lattice_spacing[3];
-                else z_frac = 0.0;
-
-                if (FOFORMAT == 0) //write ASCII file
-                {
-                  if (FOTEST) {freezeoutSurfaceFile << cell_tau << " ";}
-                  else {freezeoutSurfaceFile << cor.get_centroid_elem(i,0) + cell_tau << " ";}
-                  freezeoutSurfaceFile << cor.get_centroid_elem(i,1) + cell_x << " ";
-                  freezeoutSurfaceFile << cor.get_centroid_elem(i,2) + cell_y << " ";
-                  if (dim == 4) freezeoutSurfaceFile << cor.get_centroid_elem(i,3) + cell_z << " ";
-                  else freezeoutSurfaceFile << cell_z << " ";
-                  //then the (covariant?) surface normal element; check jacobian factors of tau for milne coordinates!
-                  //acording to cornelius user guide, corenelius returns covariant components of normal vector without jacobian factors
-                  freezeoutSurfaceFile << t * cor.get_normal_elem(i,0) << " ";
-                  freezeoutSurfaceFile << t * cor.get_normal_elem(i,1) << " ";
-                  freezeoutSurfaceFile << t * cor.get_normal_elem(i,2) << " ";
-                  if (dim == 4) freezeoutSurfaceFile << t * cor.get_normal_elem(i,3) << " ";
-                  else freezeoutSurfaceFile << 0.0 << " ";
-                  //write all the necessary hydro dynamic variables by first performing linear interpolation from values at
-                  //corners of hypercube
-
-                  if (dim == 4) // for 3+1D
-                  {
-                    //first write the contravariant flow velocity
-                    for (int ivar = 0; ivar < dim; ivar++)
-                    {
-                      temp = interpolateVariable4D(hydrodynamic_evoution, ivar, it, ix, iy, iz, tau_frac, x_frac, y_frac, z_frac);
-                      freezeoutSurfaceFile << temp << " ";
-                    }
-                    //write the energy density
-                    temp = interpolateVariable4D(hydrodynamic_evoution, 4, it, ix, iy, iz, tau_frac, x_frac, y_frac, z_frac);
-                    freezeoutSurfaceFile << temp << " "; //note : iSpectra reads in file in fm^x units e.g. energy density should be written in fm^-4
-                    //the temperature !this needs to be checked
-                    freezeoutSurfaceFile << effectiveTemperature(temp) << " ";
-                    //the thermal pressure
-                    freezeoutSurfaceFile << equilibriumPressure(temp) << " ";
-                    //write ten components of pi_(mu,nu) shear viscous tensor
-                    for (int ivar = 5; ivar < 15; ivar++)
-                    {
-                      temp = interpolateVariable4D(hydrodynamic_evoution, ivar, it, ix, iy, iz, tau_frac, x_frac, y_frac, z_frac);
-                      freezeoutSurfaceFile << temp << " ";
-                    }
-                    //write the bulk pressure Pi, and start a new line
-                    temp = interpolateVariable4D(hydrodynamic_evoution, 15, it, ix, iy, iz, tau_frac, x_frac, y_frac, z_frac);
-                    freezeoutSurfaceFile << temp << endl;
-                  }
-
-                  else //for 2+1D
-                  {
-                    //first write the flow velocity
-                    for (int ivar = 0; ivar < 4; ivar++)
-                    {
-                      temp = interpolateVariable3D(hydrodynamic_evoution, ivar, it, ix, iy, tau_frac, x_frac, y_frac);
-                      freezeoutSurfaceFile << temp << " ";
-                    }
-                    //write the energy density
-                    temp = interpolateVariable3D(hydrodynamic_evoution, 4, it, ix, iy, tau_frac, x_frac, y_frac);
-                    freezeoutSurfaceFile << temp << " "; //note units of fm^-4 appropriate for iSpectra reading
-                    //the temperature !this needs to be checked
-                    freezeoutSurfaceFile << effectiveTemperature(temp) << " ";
-                    //the thermal pressure
-                    freezeoutSurfaceFile << equilibriumPressure(temp) << " ";
-                    //write ten components of pi_(mu,nu) shear viscous tensor
-                    for (int ivar = 5; ivar < 15; ivar++)
-                    {
-                      temp = interpolateVariable3D(hydrodynamic_evoution, ivar, it, ix, iy, tau_frac, x_frac, y_frac);
-                      freezeoutSurfaceFile << temp << " ";
-                    }
-                    //write the bulk pressure Pi, and start a new line
-                    temp = interpolateVariable3D(hydrodynamic_evoution, 15, it, ix, iy, tau_frac, x_frac, y_frac);
-                    freezeoutSurfaceFile << temp << endl;
-                  }
-                }
-
-                /*
-                else //write in binary
-                {
-                  if (FOTEST) {freezeoutSurfaceFile.write(cell_tau, sizeof(double));}
-                  else {freezeoutSurfaceFile.write(cor.get_centroid_elem(i,0) + cell_tau, sizeof(double));}
-                  freezeoutSurfaceFile.write(cor.get_centroid_elem(i,1) + cell_x,sizeof(double));
-                  freezeoutSurfaceFile.write(cor.get_centroid_elem(i,2) + cell_y,sizeof(double));
-                  if (dim == 4) freezeoutSurfaceFile.write(cor.get_centroid_elem(i,3) + cell_z,sizeof(double));
-                  else freezeoutSurfaceFile.write(cell_z,sizeof(double));
-                  //then the surface normal element; note jacobian factors of +/- tau for milne coordinates
-                  freezeoutSurfaceFile.write(t * cor.get_normal_elem(i,0),sizeof(double));
-                  freezeoutSurfaceFile.write((-1.0) * t * cor.get_normal_elem(i,1),sizeof(double));
-                  freezeoutSurfaceFile.write((-1.0) * t * cor.get_normal_elem(i,2),sizeof(double));
-                  if (dim == 4) freezeoutSurfaceFile.write((-1.0) * t * cor.get_normal_elem(i,3),sizeof(double));
-                  else freezeoutSurfaceFile.write(0.0,sizeof(double));
-                  //write all the necessary hydro dynamic variables by first performing linear interpolation from values at
-                  //corners of hypercube
-
-                  if (dim == 4) // for 3+1D
-                  {
-                    //first write the flow velocity
-                    for (int ivar = 0; ivar < dim; ivar++)
-                    {
-                      temp = interpolateVariable4D(hydrodynamic_evoution, ivar, it, ix, iy, iz, tau_frac, x_frac, y_frac, z_frac);
-                      freezeoutSurfaceFile.write(temp, sizeof(double));
-                    }
-                    //write the energy density
-                    temp = interpolateVariable4D(hydrodynamic_evoution, 4, it, ix, iy, iz, tau_frac, x_frac, y_frac, z_frac);
-                    freezeoutSurfaceFile.write(temp, sizeof(double));
-                    //the temperature !this needs to be checked
-                    freezeoutSurfaceFile.write(effectiveTemperature(temp), sizeof(double));
-                    //the baryon chemical potential, writing zero for now
-                    freezeoutSurfaceFile.write(0.0, sizeof(double));
-                    //  (e + P) / T , the entropy density for zero chem. potentials !check this, note we could be a divide by zero problem if T=0!
-                    double e_plus_P_over_T = (temp + equilibriumPressure(temp)) / effectiveTemperature(temp);
-                    freezeoutSurfaceFile.write(e_plus_P_over_T, sizeof(double));
-                    //write ten components of pi_(mu,nu) shear viscous tensor
-                    for (int ivar = 5; ivar < 15; ivar++)
-                    {
-                      temp = interpolateVariable4D(hydrodynamic_evoution, ivar, it, ix, iy, iz, tau_frac, x_frac, y_frac, z_frac);
-                      freezeoutSurfaceFile.write(temp, sizeof(double));
-                    }
-                    //write the bulk pressure Pi, and start a new line
-                    temp = interpolateVariable4D(hydrodynamic_evoution, 15, it, ix, iy, iz, tau_frac, x_frac, y_frac, z_frac);
-                    freezeoutSurfaceFile.write(temp, sizeof(double));
-                  }
-
-                  else //for 2+1D
-                  {
-                    //first write the flow velocity
-                    for (int ivar = 0; ivar < 4; ivar++)
-                    {
-                      temp = interpolateVariable3D(hydrodynamic_evoution, ivar, it, ix, iy, tau_frac, x_frac, y_frac);
-                      freezeoutSurfaceFile.write(temp, sizeof(double));
-                    }
-                    //write the energy density
-                    temp = interpolateVariable3D(hydrodynamic_evoution, 4, it, ix, iy, tau_frac, x_frac, y_frac);
-                    freezeoutSurfaceFile.write(temp, sizeof(double)); //note factors of hbarc to give units (GeV/fm^3)
-                    //the temperature !this needs to be checked
-                    freezeoutSurfaceFile.write(effectiveTemperature(temp), sizeof(double));
-                    //the baryon chemical potential, writing zero for now
-                    freezeoutSurfaceFile.write(0.0, sizeof(double));
-                    //  (e + P) / T , the entropy density for zero chem. potentials !check this, note we could be a divide by zero problem if T=0!
-                    double e_plus_P_over_T = (temp + equilibriumPressure(temp)) / effectiveTemperature(temp);
-                    freezeoutSurfaceFile.write(e_plus_P_over_T, sizeof(double));
-                    //write ten components of pi_(mu,nu) shear viscous tensor
-                    for (int ivar = 5; ivar < 15; ivar++)
-                    {
-                      temp = interpolateVariable3D(hydrodynamic_evoution, ivar, it, ix, iy, tau_frac, x_frac, y_frac);
-                      freezeoutSurfaceFile.write(temp, sizeof(double));
-                    }
-                    //write the bulk pressure Pi, and start a new line
-                    temp = interpolateVariable3D(hydrodynamic_evoution, 15, it, ix, iy, tau_frac, x_frac, y_frac);
-                    freezeoutSurfaceFile.write(temp, sizeof(double));
-                  }
-                }
-                */
-              }
-            }
-          }
-        }
-      }
+      //the ring slot of the it = 0 time slice is n + 1 - freezeoutFrequency
+      int itOffset;
+      if (n <= freezeoutFrequency) itOffset = n - freezeoutFrequency - 1;
+      else itOffset = n - freezeoutFrequency;
+      #if FOPIPELINE
+      submitFreezeoutWindow(&freezeoutPipeline, n + 1 - freezeoutFrequency, start, freezeoutFrequency, itOffset, t);
+      #else
+      findFreezeoutSurface(&history, n + 1 - freezeoutFrequency, start, freezeoutFrequency, itOffset, dim, nFreezeout,
+        freezeoutEnergyDensities, lattice_spacing, t, t0, dt, dx, dy, dz, output->freezeoutCellTime, surfaces, particleSpectra, &coalescing);
+      #endif
     }
 
     //if all cells are below freezeout temperature end hydro
-    accumulator1 = 0;
-    for (int ix = 2; ix < nx+2; ix++)
-    {
-      for (int iy = 2; iy < ny+2; iy++)
-      {
-        for (int iz = 2; iz < nz+2; iz++)
-        {
-          int s = columnMajorLinearIndex(ix, iy, iz, nx+4, ny+4);
-          if (e[s] > freezeoutEnergyDensity) accumulator1 = accumulator1 + 1;
-        }
-      }
-    }
-    if (accumulator1 == 0) accumulator2 += 1;
-    if (accumulator2 >= FOFREQ+1) //only break once freezeout finder has had a chance to search/write to file
+    if (cellReductions.hotCells == 0) accumulator2 += 1;
+    if (accumulator2 >= freezeoutFrequency+1) //only break once freezeout finder has had a chance to search/write to file
     {
       printf("\nAll cells have dropped below freezeout energy density\n");
       break;
@@ -429,7 +506,7 @@ void run(void * latticeParams, void * initCondParams, void * hydroParams, const
     rungeKutta2(t, dt, q, Q, latticeParams, hydroParams);
     t2 = std::clock();
     double delta_time = (t2 - t1) / (double)(CLOCKS_PER_SEC / 1000);
-    if ((n-1) % FREQ == 0) printf("(Elapsed time: %.3f ms)\n",delta_time);
+    if ((n-1) % outputFrequency == 0) printf("(Elapsed time: %.3f ms)\n",delta_time);
     totalTime+=delta_time;
     ++nsteps;
 
@@ -438,17 +515,51 @@ void run(void * latticeParams, void * initCondParams, void * hydroParams, const
     t = t0 + n * dt;
   }
   printf("Average time/step: %.3f ms\n",totalTime/((double)nsteps));
+  #if FOPIPELINE
+  finishFreezeoutPipeline(&freezeoutPipeline);
+  printf("Time spent waiting for the freezeout finder: %.3f s\n", freezeoutPipeline.waitTime);
+  #endif
+  printf("Freezeout history: %.1f%% of the cells stored with all variables on average\n",
+    100.0 * history.capturedCells / ((double)history.capturedSteps * history.ncells));
+  if (history.lateStoredCells)
+    printf("Freezeout history: the variables of %ld cells were stored a step late, at crossings that were not predicted\n",
+      history.lateStoredCells);
+  if (coalescing.cells > 0)
+    printf("Freezeout surface coalescing: %ld elements merged into %ld (compression ratio %.2f)\n",
+      history.foundElements, history.keptElements, history.keptElements ? (double)history.foundElements / history.keptElements : 1.0);
+  if (regulationNaNs.pipi || regulationNaNs.spipi || regulationNaNs.a1 || regulationNaNs.rho || regulationNaNs.fac
+    || regulationNaNs.rhoBulk || regulationNaNs.facBulk)
+  {
+    printf("NaNs found while regulating dissipative currents: pipi=%ld, spipi=%ld, a1=%ld, rho=%ld, fac=%ld, rhoBulk=%ld, facBulk=%ld\n",
+    regulationNaNs.pipi, regulationNaNs.spipi, regulationNaNs.a1, regulationNaNs.rho, regulationNaNs.fac,
+    regulationNaNs.rhoBulk, regulationNaNs.facBulk);
+  }
 
-  freezeoutSurfaceFile.close();
+  finishSnapshotWriter(&snapshotWriter);
+  printf("%ld snapshots of the fluid written to %s, time spent waiting for the output thread: %.3f s\n",
+    snapshotWriter.file.numberOfSnapshots, outputDir, snapshotWriter.waitTime);
+  for (int k = 0; k < nFreezeout && surfaces; k++)
+  {
+    printf("%ld freezeout surface elements written to %s\n", freezeoutSurfaceFiles[k].numberOfElements, freezeoutSurfacePaths[k]);
+    closeFreezeoutSurfaceFile(&freezeoutSurfaceFiles[k]);
+  }
+  for (int k = 0; k < nFreezeout && particleSpectra; k++)
+  {
+    char spectraPath[255], flowPath[255];
+    cooperFryeFilePath(spectraPath, outputDir, "spectra", nFreezeout, hydro->freezeoutTemperaturesGeV[k]);
+    cooperFryeFilePath(flowPath, outputDir, "flow", nFreezeout, hydro->freezeoutTemperaturesGeV[k]);
+    writeCooperFryeSpectra(&cooperFryeSpectra[k], spectraPath);
+    writeCooperFryeFlow(&cooperFryeSpectra[k], flowPath);
+    printf("spectra of %d hadrons from %ld freezeout surface elements written to %s and %s\n",
+      cooperFryeSpectra[k].numberOfHadrons, cooperFryeSpectra[k].numberOfElements, spectraPath, flowPath);
+    freeCooperFryeSpectra(&cooperFryeSpectra[k]);
+  }
   /************************************************************************************	\
   * Deallocate host memory
   /************************************************************************************/
   freeHostMemory();
 
   //Deallocate memory used for freezeout finding
-  free4dArray(energy_density_evoution, FOFREQ+1, nx, ny);
-  free5dArray(hydrodynamic_evoution, n_hydro_vars, FOFREQ+1, nx, ny);
+  freeFreezeoutHistory(&history);
   delete [] lattice_spacing;
-
-  free4dArray(hyperCube4D, 2, 2, 2);
 }
@@ -8,6 +8,7 @@
 #ifndef HYDROPLUGIN_H_
 #define HYDROPLUGIN_H_
 
-void run(void * latticeParams, void * initCondParams, void * hydroParams, const char *rootDirectory, const char *outputDir);
+void run(void * latticeParams, void * initCondParams, void * hydroParams, void * spectraParams, void * outputParams,
+		const char *rootDirectory, const char *outputDir, const char *restartFile);
 
 #endif /* HYDROPLUGIN_H_ */
@@ -0,0 +1,141 @@
+/*
+ * PimunuSourceTermsGenerated.h
+ *
+ * GENERATED by codegen/generate_source_terms.py -- do not edit by hand,
+ * regenerate with `make sources`.
+ *
+ * 100 common subexpressions, 792 floating point operations per cell.
+ */
+
+#ifndef PIMUNUSOURCETERMSGENERATED_H_
+#define PIMUNUSOURCETERMSGENERATED_H_
+
+#include "../hydro/DynamicalVariables.h"
+#include "../hydro/SourceTerms.h"
+
+static inline void pimunuSourceTermsKernel(PRECISION * const __restrict__ pimunuRHS,
+		const PROPER_TIME_FACTORS * const __restrict__ tf,
+		PRECISION ut, PRECISION ux, PRECISION uy, PRECISION un, PRECISION utp, PRECISION uxp, PRECISION uyp, PRECISION unp, PRECISION utInv,
+		PRECISION pitt, PRECISION pitx, PRECISION pity,
+		PRECISION pitn, PRECISION pixx, PRECISION pixy, PRECISION pixn, PRECISION piyy,
+		PRECISION piyn, PRECISION pinn, PRECISION Pi,
+		PRECISION dxut, PRECISION dyut, PRECISION dnut, PRECISION dxux, PRECISION dyux, PRECISION dnux,
+		PRECISION dxuy, PRECISION dyuy, PRECISION dnuy, PRECISION dxun, PRECISION dyun, PRECISION dnun, PRECISION dkvk,
+		PRECISION beta_pi, PRECISION beta_Pi, PRECISION lambda_Pipi
+) {
+	const PRECISION x0 = pitn*un;
+	const PRECISION x1 = 2*x0;
+	const PRECISION x2 = tf->tInv*ut;
+	const PRECISION x3 = tf->dtInv*(ut - utp);
+	const PRECISION x4 = dnun + dxux + dyuy + x2 + x3;
+	const PRECISION x5 = delta_pipi*x4;
+	const PRECISION x6 = un*un;
+	const PRECISION x7 = tf->t*x6;
+	const PRECISION x8 = dnut*un + dxut*ux + dyut*uy + ut*x3;
+	const PRECISION x9 = ut*ut;
+	const PRECISION x10 = x9 - 1;
+	const PRECISION x11 = (1.0/3.0)*x4;
+	const PRECISION x12 = -ut*x7 - ut*x8 + x10*x11 + x3;
+	const PRECISION x13 = 2*beta_pi;
+	const PRECISION x14 = Pi*lambda_piPi;
+	const PRECISION x15 = 0.5*x7;
+	const PRECISION x16 = ux*x15;
+	const PRECISION x17 = ux - uxp;
+	const PRECISION x18 = tf->dtInv*x17;
+	const PRECISION x19 = dnux*un + dxux*ux + dyux*uy + ut*x18;
+	const PRECISION x20 = ut*x19;
+	const PRECISION x21 = 0.5*(dxut + x18) + 0.5*(ux*x8 - x20) + x16;
+	const PRECISION x22 = 2*pitx*x21;
+	const PRECISION x23 = uy*x15;
+	const PRECISION x24 = uy - uyp;
+	const PRECISION x25 = tf->dtInv*x24;
+	const PRECISION x26 = dnuy*un + dxuy*ux + dyuy*uy + ut*x25;
+	const PRECISION x27 = ut*x26;
+	const PRECISION x28 = 0.5*(dyut + x25) + 0.5*(uy*x8 - x27) + x23;
+	const PRECISION x29 = 2*pity*x28;
+	const PRECISION x30 = tf->t*un;
+	const PRECISION x31 = un - unp;
+	const PRECISION x32 = tf->dtInv*x31;
+	const PRECISION x33 = un*x8;
+	const PRECISION x34 = 2*un;
+	const PRECISION x35 = dnun*un + dxun*ux + dyun*uy + ut*x32;
+	const PRECISION x36 = tf->t2*(x2*x34 + x35);
+	const PRECISION x37 = 0.5*tf->t3*un*un*un + 0.5*(dnut + tf->t2*x32 + 2*x30) + tf->t2*x33 + ut*x36;
+	const PRECISION x38 = 2*pitn*x37;
+	const PRECISION x39 = -x19;
+	const PRECISION x40 = -x26;
+	const PRECISION x41 = x7 + x8;
+	const PRECISION x42 = 0.5*(-dxut + tf->dtInv*x17) - 0.5*(ux*x8 + x20) + (1.0/3.0)*ut*ux*x4 - x16;
+	const PRECISION x43 = pitx*x42;
+	const PRECISION x44 = 0.5*(-dyut + tf->dtInv*x24) - 0.5*(uy*x8 + x27) + (1.0/3.0)*ut*uy*x4 - x23;
+	const PRECISION x45 = pity*x44;
+	const PRECISION x46 = tf->t2*x6;
+	const PRECISION x47 = -0.5*tf->tInv*un*(x46 + 2*x9) + 0.5*(-dnut*tf->t2Inv + tf->dtInv*x31) - 0.5*(ut*x35 + x33) + (1.0/3.0)*un*ut*x4;
+	const PRECISION x48 = pitn*tf->t2*x47;
+	const PRECISION x49 = ux*ux + 1;
+	const PRECISION x50 = (1.0/3.0)*x4*x49 - dxux - ux*x19;
+	const PRECISION x51 = pixx*x50;
+	const PRECISION x52 = uy*uy + 1;
+	const PRECISION x53 = (1.0/3.0)*x4*x52 - dyuy - uy*x26;
+	const PRECISION x54 = piyy*x53;
+	const PRECISION x55 = tf->t2Inv + x6;
+	const PRECISION x56 = (1.0/3.0)*x4*x55 - dnun*tf->t2Inv - tf->t3Inv*ut*(2*x46 + 1) - un*x35;
+	const PRECISION x57 = pinn*x56;
+	const PRECISION x58 = ux*x26;
+	const PRECISION x59 = 0.5*(-dxuy - dyux) - 0.5*(uy*x19 + x58) + ux*uy*x11;
+	const PRECISION x60 = pixy*x59;
+	const PRECISION x61 = un*x2;
+	const PRECISION x62 = un*x19;
+	const PRECISION x63 = -0.5*(dnux*tf->t2Inv + dxun) - 0.5*(ux*x35 + x62) + (1.0/3.0)*un*ux*x4 - ux*x61;
+	const PRECISION x64 = pixn*x63;
+	const PRECISION x65 = tf->t2*x64;
+	const PRECISION x66 = un*x26;
+	const PRECISION x67 = -0.5*(dnuy*tf->t2Inv + dyun) - 0.5*(uy*x35 + x66) + (1.0/3.0)*un*uy*x4 - uy*x61;
+	const PRECISION x68 = piyn*x67;
+	const PRECISION x69 = tf->t2*x68;
+	const PRECISION x70 = pitt*x12 + tf->t2*tf->t2*x57 - 2*x43 - 2*x45 - 2*x48 + x51 + x54 + 2*x60 + 2*x65 + 2*x69;
+	const PRECISION x71 = pixn*un;
+	const PRECISION x72 = pity*ux;
+	const PRECISION x73 = pixy*ut;
+	const PRECISION x74 = pitn*ux;
+	const PRECISION x75 = pixn*ut;
+	const PRECISION x76 = 0.5*(-dxuy + dyux) + 0.5*(uy*x19 - x58);
+	const PRECISION x77 = 0.5*(dnux - dxun*tf->t2) + 0.5*(tf->t2*x62 + ux*x36);
+	const PRECISION x78 = 0.5*tf->t2;
+	const PRECISION x79 = piyn*un;
+	const PRECISION x80 = pitx*uy;
+	const PRECISION x81 = pitn*uy;
+	const PRECISION x82 = piyn*ut;
+	const PRECISION x83 = -x76;
+	const PRECISION x84 = 0.5*(dnuy - dyun*tf->t2) + 0.5*(tf->t2*x66 + uy*x36);
+	const PRECISION x85 = pitn*ut + pitt*un;
+	const PRECISION x86 = pitx*un;
+	const PRECISION x87 = x75 + x86;
+	const PRECISION x88 = pity*un;
+	const PRECISION x89 = x82 + x88;
+	const PRECISION x90 = pinn*ut;
+	const PRECISION x91 = -tf->t2Inv*x77;
+	const PRECISION x92 = -tf->t2Inv*x84;
+	const PRECISION x93 = tf->t2Inv*x37;
+	const PRECISION x94 = 2*pixy;
+	const PRECISION x95 = 2*pixn;
+	const PRECISION x96 = pixn*uy;
+	const PRECISION x97 = piyn*ux;
+	const PRECISION x98 = pixy*un;
+	const PRECISION x99 = 2*piyn;
+	pimunuRHS[0] = dkvk*pitt + utInv*(-pitt*x5 - tau_pipi*((1.0/3.0)*x10*x70 + pitt*x12 - x43 - x45 - x48) - tf->t*x1 - 2*ut*(-pitn*x36 + pitt*x41 + pitx*x39 + pity*x40) + x12*x13 + x12*x14 + x22 + x29 + x38);
+	pimunuRHS[1] = dkvk*pitx + utInv*(pitn*x77 + pitt*x21 - pitx*x5 + pity*x76 + pixn*x37 + pixx*x21 + pixy*x28 - tau_pipi*(0.5*(pitt*x42 + pitx*x12) - 0.5*(pitx*x50 + pixx*x42) - 0.5*(pity*x59 + pixy*x44) + (1.0/3.0)*ut*ux*x70 - x78*(pitn*x63 + pixn*x47)) - tf->t*x71 + x13*x42 + x14*x42 + x36*(x74 + x75) - x39*(pitx*ux + pixx*ut) - x40*(x72 + x73) - x41*(pitt*ux + pitx*ut));
+	pimunuRHS[2] = dkvk*pity + utInv*(pitn*x84 + pitt*x28 + pitx*x83 - pity*x5 + pixy*x21 + piyn*x37 + piyy*x28 - tau_pipi*(0.5*(pitt*x44 + pity*x12) - 0.5*(pitx*x59 + pixy*x42) - 0.5*(pity*x53 + piyy*x44) + (1.0/3.0)*ut*uy*x70 - x78*(pitn*x67 + piyn*x47)) - tf->t*x79 + x13*x44 + x14*x44 + x36*(x81 + x82) - x39*(x73 + x80) - x40*(pity*uy + piyy*ut) - x41*(pitt*uy + pity*ut));
+	pimunuRHS[3] = dkvk*pitn + utInv*(-pinn*x30 + pinn*x37 - pitn*x5 + pitt*x93 + pitx*x91 + pity*x92 + pixn*x21 + piyn*x28 - tau_pipi*(0.5*(pitn*x12 + pitt*x47) - 0.5*(pitx*x63 + pixn*x42) - 0.5*(pity*x67 + piyn*x44) + (1.0/3.0)*un*ut*x70 - x78*(pinn*x47 + pitn*x56)) - tf->tInv*x85 + x13*x47 + x14*x47 + x36*(x0 + x90) - x39*x87 - x40*x89 - x41*x85);
+	pimunuRHS[4] = dkvk*pixx + utInv*(-pixx*x5 - tau_pipi*((1.0/3.0)*x49*x70 + x43 - x51 - x60 - x65) - 2*ux*(pitx*x41 - pixn*x36 + pixx*x39 + pixy*x40) + x13*x50 + x14*x50 + x22 + x76*x94 + x77*x95);
+	pimunuRHS[5] = dkvk*pixy + utInv*(pitx*x28 + pity*x21 + pixn*x84 + pixx*x83 - pixy*x5 + piyn*x77 + piyy*x76 - tau_pipi*(0.5*(pitx*x44 + pity*x42) - 0.5*(pixx*x59 + pixy*x50) - 0.5*(pixy*x53 + piyy*x59) + (1.0/3.0)*ux*uy*x70 - x78*(pixn*x67 + piyn*x63)) + x13*x59 + x14*x59 + x36*(x96 + x97) - x39*(pixx*uy + pixy*ux) - x40*(pixy*uy + piyy*ux) - x41*(x72 + x80));
+	pimunuRHS[6] = dkvk*pixn + utInv*(pinn*x77 + pitn*x21 + pitx*x93 - pixn*x5 + pixx*x91 + pixy*x92 + piyn*x76 - tau_pipi*(0.5*(pitn*x42 + pitx*x47) - 0.5*(pixn*x50 + pixx*x63) - 0.5*(pixy*x67 + piyn*x59) + (1.0/3.0)*un*ux*x70 - x78*(pinn*x63 + pixn*x56)) - tf->tInv*x87 + x13*x63 + x14*x63 + x36*(pinn*ux + x71) - x39*(pixn*ux + pixx*un) - x40*(x97 + x98) - x41*(x74 + x86));
+	pimunuRHS[7] = dkvk*piyy + utInv*(-piyy*x5 - tau_pipi*((1.0/3.0)*x52*x70 + x45 - x54 - x60 - x69) - 2*uy*(pity*x41 + pixy*x39 - piyn*x36 + piyy*x40) + x13*x53 + x14*x53 + x29 + x83*x94 + x84*x99);
+	pimunuRHS[8] = dkvk*piyn + utInv*(pinn*x84 + pitn*x28 + pity*x93 + pixn*x83 + pixy*x91 - piyn*x5 + piyy*x92 - tau_pipi*(0.5*(pitn*x44 + pity*x47) - 0.5*(pixn*x59 + pixy*x63) - 0.5*(piyn*x53 + piyy*x67) + (1.0/3.0)*un*uy*x70 - x78*(pinn*x67 + piyn*x56)) - tf->tInv*x89 + x13*x67 + x14*x67 + x36*(pinn*uy + x79) - x39*(x96 + x98) - x40*(piyn*uy + piyy*un) - x41*(x81 + x88));
+	pimunuRHS[9] = dkvk*pinn + utInv*(-pinn*x5 - tau_pipi*((1.0/3.0)*x55*x70 + pitn*x47 - tf->t2*x57 - x64 - x68) + tf->t2Inv*x38 - tf->tInv*(x1 + 2*x90) + x13*x56 + x14*x56 - x34*(-pinn*x36 + pitn*x41 + pixn*x39 + piyn*x40) + x91*x95 + x92*x99);
+#ifdef PI
+	pimunuRHS[10] = Pi*dkvk + utInv*(-Pi*delta_PiPi*x4 - beta_Pi*x4 + lambda_Pipi*x70);
+#endif
+}
+
+#endif /* PIMUNUSOURCETERMSGENERATED_H_ */
@@ -10,6 +10,24 @@
 
 #include "../hydro/DynamicalVariables.h"
 
+// integrate the relaxation terms -\pi^{\mu\nu}/\tau_\pi and -\Pi/\tau_\Pi exactly (second order exponential Runge-Kutta),
+// so that dt is limited by the CFL condition rather than by \tau_\pi; comment out to treat them explicitly
+#define EXPONENTIAL_RELAXATION
+
+// powers of the proper time and 1/dt, computed once per Euler step
+typedef struct
+{
+	PRECISION t;
+	PRECISION t2;
+	PRECISION t3;
+	PRECISION tInv;
+	PRECISION t2Inv;
+	PRECISION t3Inv;
+	PRECISION dtInv;
+} PROPER_TIME_FACTORS;
+
+void setProperTimeFactors(PROPER_TIME_FACTORS * const __restrict__ tf, PRECISION t, PRECISION dt);
+
 void loadSourceTerms(
 const PRECISION * const __restrict__ I, const PRECISION * const __restrict__ J, const PRECISION * const __restrict__ K, 
 const PRECISION * const __restrict__ Q, PRECISION * const __restrict__ S,
@@ -32,10 +50,13 @@ void loadSourceTermsZ(const PRECISION * const __restrict__ K, PRECISION * const
 PRECISION d_dz
 );
 
-void loadSourceTerms2(const PRECISION * const __restrict__ Q, PRECISION * const __restrict__ S, const FLUID_VELOCITY * const __restrict__ u,
+// S: source terms without the stiff relaxation terms, R: relaxation rates of \pi^{\mu\nu} and \Pi
+// (without EXPONENTIAL_RELAXATION the relaxation terms are included in S and R is zero)
+void loadSourceTerms2(const PRECISION * const __restrict__ Q, PRECISION * const __restrict__ S, PRECISION * const __restrict__ R,
+const FLUID_VELOCITY * const __restrict__ u,
 PRECISION utp, PRECISION uxp, PRECISION uyp, PRECISION unp,
-PRECISION t, PRECISION e, const PRECISION * const __restrict__ pvec,
-int s, int d_ncx, int d_ncy, int d_ncz, PRECISION d_etabar, PRECISION d_dt, PRECISION d_dx, PRECISION d_dy, PRECISION d_dz
+const PROPER_TIME_FACTORS * const __restrict__ tf, PRECISION e, const PRECISION * const __restrict__ pvec,
+int s, int d_ncx, int d_ncy, int d_ncz, PRECISION d_dx, PRECISION d_dy, PRECISION d_dz
 );
 
 #endif /* SOURCETERMS_H_ */
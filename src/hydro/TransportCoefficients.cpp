@@ -0,0 +1,96 @@
+/*
+ * TransportCoefficients.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <stdio.h> // for printf
+#include <math.h> // for math functions
+
+#include "../hydro/TransportCoefficients.h"
+#include "../hydro/HydroParameters.h"
+#include "../eos/EquationOfState.h"
+
+// paramters for the analytic parameterization of the bulk viscosity \zeta/S
+#define A_1 -13.77
+#define A_2 27.55
+#define A_3 13.45
+
+#define LAMBDA_1 0.9
+#define LAMBDA_2 0.25
+#define LAMBDA_3 0.9
+#define LAMBDA_4 0.22
+
+#define SIGMA_1 0.025
+#define SIGMA_2 0.13
+#define SIGMA_3 0.0025
+#define SIGMA_4 0.022
+
+// {\eta/s, \zeta/s} at T = n * dT, interleaved so that both are fetched with one cache line
+static PRECISION transportTable[TRANSPORT_TABLE_SIZE][2];
+static PRECISION transportTableInvDT;
+
+static double parameterizedBulkViscosityToEntropyDensity(double T) {
+	double x = T/1.01355;
+	if(x > 1.05)
+		return LAMBDA_1*exp(-(x-1)/SIGMA_1) + LAMBDA_2*exp(-(x-1)/SIGMA_2)+0.001;
+	else if(x < 0.995)
+		return LAMBDA_3*exp((x-1)/SIGMA_3)+ LAMBDA_4*exp((x-1)/SIGMA_4)+0.03;
+	else
+		return A_1*x*x + A_2*x - A_3;
+}
+
+void initializeTransportCoefficients(void * hydroParams) {
+	struct HydroParameters * hydro = (struct HydroParameters *) hydroParams;
+
+	const double hbarc = 0.197326938;
+	double etabarMin = hydro->shearViscosityToEntropyDensity;
+	double etabarSlope = hydro->shearViscositySlopeGeV * hbarc;
+	double Tkink = hydro->shearViscosityKinkTemperatureGeV / hbarc;
+	double zetabarMax = hydro->bulkViscosityMax;
+	double Tpeak = hydro->bulkViscosityPeakTemperatureGeV / hbarc;
+	double width = hydro->bulkViscosityWidthGeV / hbarc;
+
+	double dT = TRANSPORT_TABLE_MAX_TEMPERATURE_GEV / hbarc / (TRANSPORT_TABLE_SIZE - 1);
+	transportTableInvDT = (PRECISION)(1/dT);
+
+	for(int n = 0; n < TRANSPORT_TABLE_SIZE; ++n) {
+		double T = n * dT;
+
+		double etabar = etabarMin;
+		if(T > Tkink) etabar += etabarSlope * (T - Tkink);
+
+		double zetabar;
+		if(hydro->bulkViscosityProfile == BULK_VISCOSITY_CAUCHY) {
+			double x = (T - Tpeak) / width;
+			zetabar = zetabarMax / (1 + x*x);
+		}
+		else zetabar = parameterizedBulkViscosityToEntropyDensity(T);
+
+		transportTable[n][0] = (PRECISION)etabar;
+		transportTable[n][1] = (PRECISION)zetabar;
+	}
+
+	printf("eta/s(T) = %.3f + %.3f/GeV * (T - %.3f GeV) above the kink\n",
+		etabarMin, hydro->shearViscositySlopeGeV, hydro->shearViscosityKinkTemperatureGeV);
+	if(hydro->bulkViscosityProfile == BULK_VISCOSITY_CAUCHY)
+		printf("zeta/s(T) = %.3f / (1 + ((T - %.3f GeV)/%.3f GeV)^2)\n",
+			zetabarMax, hydro->bulkViscosityPeakTemperatureGeV, hydro->bulkViscosityWidthGeV);
+	else
+		printf("zeta/s(T) from the analytic parameterization\n");
+}
+
+void getTransportCoefficients(PRECISION e, TRANSPORT_COEFFICIENTS * const __restrict__ tc) {
+	temperatureAndSpeedOfSoundSquared(e, &tc->T, &tc->cs2);
+	const PRECISION T = tc->T;
+
+	PRECISION x = fmin(T * transportTableInvDT, (PRECISION)(TRANSPORT_TABLE_SIZE - 1));
+	int n = (int)x;
+	n = n < TRANSPORT_TABLE_SIZE - 2 ? n : TRANSPORT_TABLE_SIZE - 2;
+	PRECISION w = x - n;
+
+	const PRECISION * const f0 = transportTable[n];
+	const PRECISION * const f1 = transportTable[n+1];
+	tc->etabar = f0[0] + w * (f1[0] - f0[0]);
+	tc->zetabar = f0[1] + w * (f1[1] - f0[1]);
+}
@@ -0,0 +1,34 @@
+/*
+ * TransportCoefficients.h
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TRANSPORTCOEFFICIENTS_H_
+#define TRANSPORTCOEFFICIENTS_H_
+
+#include "../hydro/DynamicalVariables.h"
+
+// \eta/s(T) and \zeta/s(T) are tabulated on a uniform temperature grid [0, TRANSPORT_TABLE_MAX_TEMPERATURE_GEV]
+// and linearly interpolated; temperatures above the grid use the last entry
+#define TRANSPORT_TABLE_SIZE 16384
+#define TRANSPORT_TABLE_MAX_TEMPERATURE_GEV 1.5
+
+// parameterizations of \zeta/s(T) selected by bulkViscosityProfile in hydro.properties
+#define BULK_VISCOSITY_PARAMETERIZED 0
+#define BULK_VISCOSITY_CAUCHY 1
+
+// equation of state and transport coefficients of a cell, evaluated together
+typedef struct
+{
+	PRECISION T;
+	PRECISION cs2;
+	PRECISION etabar;
+	PRECISION zetabar;
+} TRANSPORT_COEFFICIENTS;
+
+void initializeTransportCoefficients(void * hydroParams);
+
+void getTransportCoefficients(PRECISION e, TRANSPORT_COEFFICIENTS * const __restrict__ tc);
+
+#endif /* TRANSPORTCOEFFICIENTS_H_ */
@@ -0,0 +1,320 @@
+/*
+ * InitialConditionFile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <omp.h>
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+#include "../ic/InitialConditionFile.h"
+#include "../io/SnapshotFile.h"
+#include "../lattice/LatticeParameters.h"
+#include "../hydro/DynamicalVariables.h"
+
+#define MAX_INITIAL_CONDITION_COLUMNS 64
+// cells along x and eta of the tiles in which the values are transposed to the lattice
+#define INITIAL_CONDITION_TILE 16
+
+typedef struct
+{
+	const char *data;
+	size_t size;
+} MAPPED_FILE;
+
+static void mapInitialConditionFile(MAPPED_FILE * const file, const char *path) {
+	int fd = open(path, O_RDONLY);
+	if(fd < 0) {
+		printf("Couldn't open %s!\n", path);
+		exit(-1);
+	}
+	struct stat st;
+	fstat(fd, &st);
+	file->size = st.st_size;
+	file->data = NULL;
+	if(file->size > 0) {
+		void *data = mmap(NULL, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data == MAP_FAILED) {
+			printf("Couldn't map %s into memory!\n", path);
+			exit(-1);
+		}
+		// the threads read their parts of the file at once
+		madvise(data, file->size, MADV_WILLNEED);
+		file->data = (const char *)data;
+	}
+	close(fd);
+}
+
+static void unmapInitialConditionFile(MAPPED_FILE * const file) {
+	if(file->data) munmap((void *)file->data, file->size);
+	file->data = NULL;
+}
+
+static inline bool isSeparator(char c) {
+	return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// the number at begin, which ends at the next separator or at end, as float, rounded like strtof; returns the end of
+// the number, or NULL if it is not a number. The standard libraries without std::from_chars for float (e.g. libc++
+// of older Xcode) parse with strtof only
+static const char * parseFloat(const char *begin, const char *end, float *value) {
+#if defined(__cpp_lib_to_chars)
+	const char *start = *begin == '+' ? begin + 1 : begin;
+	std::from_chars_result result = std::from_chars(start, end, *value);
+	if(result.ec == std::errc() && (result.ptr == end || isSeparator(*result.ptr))) return result.ptr;
+#endif
+	// what from_chars does not take but fscanf did: values beyond the range of float, hexadecimal numbers, ...;
+	// strtof needs the number in a terminated string, which the mapped file is not
+	const char *stop = begin;
+	while(stop < end && !isSeparator(*stop)) ++stop;
+	char buffer[64];
+	size_t length = stop - begin;
+	if(length >= sizeof(buffer)) return NULL;
+	memcpy(buffer, begin, length);
+	buffer[length] = '\0';
+	char *bufferStop;
+	*value = strtof(buffer, &bufferStop);
+	return bufferStop == buffer + length ? stop : NULL;
+}
+
+void readInitialConditionColumns(const char *path, void * latticeParams, int numberOfColumns, PRECISION * const * columns) {
+	struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
+	const int nx = lattice->numLatticePointsX;
+	const int ny = lattice->numLatticePointsY;
+	const int nz = lattice->numLatticePointsRapidity;
+	const long numbers = (long)nx * ny * nz * numberOfColumns;
+	if(numberOfColumns > MAX_INITIAL_CONDITION_COLUMNS) {
+		printf("%s: at most %d columns can be read!\n", path, MAX_INITIAL_CONDITION_COLUMNS);
+		exit(-1);
+	}
+
+	MAPPED_FILE file;
+	mapInitialConditionFile(&file, path);
+	const char * const data = file.data;
+	const size_t size = file.size;
+
+	// the file is split into chunks at white space, so that each number is in one chunk; the numbers are counted
+	// in each chunk, which gives the index of the first number of each chunk, and then parsed in parallel
+	const int numberOfChunks = 4 * omp_get_max_threads();
+	size_t *chunks = (size_t *)malloc((numberOfChunks + 1) * sizeof(size_t));
+	long *firstNumbers = (long *)malloc((numberOfChunks + 1) * sizeof(long));
+	for(int c = 0; c <= numberOfChunks; ++c) {
+		size_t b = c == numberOfChunks ? size : (size_t)((double)size * c / numberOfChunks);
+		while(c > 0 && b < size && !isSeparator(data[b])) ++b;
+		chunks[c] = b;
+	}
+	#pragma omp parallel for schedule(dynamic)
+	for(int c = 0; c < numberOfChunks; ++c) {
+		long count = 0;
+		bool separator = true;
+		for(size_t b = chunks[c]; b < chunks[c+1]; ++b) {
+			bool s = isSeparator(data[b]);
+			if(separator && !s) count++;
+			separator = s;
+		}
+		firstNumbers[c+1] = count;
+	}
+	firstNumbers[0] = 0;
+	for(int c = 0; c < numberOfChunks; ++c) firstNumbers[c+1] += firstNumbers[c];
+	if(firstNumbers[numberOfChunks] != numbers) {
+		printf("%s has %ld numbers, %d per cell of the %d x %d x %d lattice are %ld!\n", path, firstNumbers[numberOfChunks],
+				numberOfColumns, nx, ny, nz, numbers);
+		exit(-1);
+	}
+
+	// the values are parsed in the order of the file into a float array per column, and then transposed to the lattice
+	// in tiles, since the file has eta fastest and the lattice x fastest
+	const long ncells = (long)nx * ny * nz;
+	int stagingColumns[MAX_INITIAL_CONDITION_COLUMNS];
+	int numberOfStagingColumns = 0;
+	for(int column = 0; column < numberOfColumns; ++column) stagingColumns[column] = columns[column] ? numberOfStagingColumns++ : -1;
+	float *staging = (float *)malloc(numberOfStagingColumns * ncells * sizeof(float));
+	if(!staging) {
+		printf("Could not allocate the buffer to read %s!\n", path);
+		exit(-1);
+	}
+
+	// the first value that is not a number is reported, by whichever thread finds one first
+	bool invalid = false;
+	#pragma omp parallel for schedule(dynamic)
+	for(int c = 0; c < numberOfChunks; ++c) {
+		long cell = firstNumbers[c] / numberOfColumns;
+		int column = firstNumbers[c] % numberOfColumns;
+		size_t b = chunks[c];
+		const size_t end = chunks[c+1];
+		while(true) {
+			while(b < end && isSeparator(data[b])) ++b;
+			if(b == end) break;
+			const size_t start = b;
+			const char *stop = NULL;
+			if(stagingColumns[column] >= 0) stop = parseFloat(data + b, data + end, staging + stagingColumns[column] * ncells + cell);
+			if(stop) b = stop - data;
+			else {
+				while(b < end && !isSeparator(data[b])) ++b;
+				if(stagingColumns[column] >= 0) {
+					#pragma omp critical
+					{
+						// the cells are listed with x slowest and eta fastest
+						if(!invalid) printf("%s: %.*s in cell (%ld, %ld, %ld) is not a number!\n", path, (int)(b - start),
+								data + start, cell / ((long)ny * nz), (cell / nz) % ny, cell % nz);
+						invalid = true;
+					}
+				}
+			}
+			if(++column == numberOfColumns) {
+				column = 0;
+				cell++;
+			}
+		}
+	}
+	if(invalid) exit(-1);
+
+	#pragma omp parallel for collapse(2)
+	for(int j = 0; j < ny; ++j) {
+		for(int i0 = 0; i0 < nx; i0 += INITIAL_CONDITION_TILE) {
+			const int i1 = i0 + INITIAL_CONDITION_TILE < nx ? i0 + INITIAL_CONDITION_TILE : nx;
+			for(int k0 = 0; k0 < nz; k0 += INITIAL_CONDITION_TILE) {
+				const int k1 = k0 + INITIAL_CONDITION_TILE < nz ? k0 + INITIAL_CONDITION_TILE : nz;
+				for(int column = 0; column < numberOfColumns; ++column) {
+					if(stagingColumns[column] < 0) continue;
+					const float * const values = staging + stagingColumns[column] * ncells;
+					for(int k = k0; k < k1; ++k) {
+						PRECISION * const row = columns[column] + columnMajorLinearIndex(2, j+2, k+2, nx+4, ny+4);
+						for(int i = i0; i < i1; ++i) row[i] = (PRECISION) values[((long)i * ny + j) * nz + k];
+					}
+				}
+			}
+		}
+	}
+
+	free(staging);
+	free(chunks);
+	free(firstNumbers);
+	unmapInitialConditionFile(&file);
+}
+
+double readInitialConditionSnapshot(const char *path, void * latticeParams, int numberOfFields, const char * const * names,
+		const int * required, PRECISION * const * fields) {
+	struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
+	const int nx = lattice->numLatticePointsX;
+	const int ny = lattice->numLatticePointsY;
+	const int nz = lattice->numLatticePointsRapidity;
+
+	MAPPED_FILE file;
+	mapInitialConditionFile(&file, path);
+	const char * const data = file.data;
+	size_t offset = 8 + 8 * sizeof(int32_t);
+	int32_t header[8];
+	if(file.size < offset || memcmp(data, SNAPSHOT_BINARY_MAGIC, 8)) {
+		printf("%s is not a snapshot file!\n", path);
+		exit(-1);
+	}
+	memcpy(header, data + 8, sizeof(header));
+	const int version = header[0];
+	if(header[1] != 0x01020304 || version < 1 || version > SNAPSHOT_BINARY_VERSION || (header[5] != 4 && header[5] != 8)) {
+		printf("%s: snapshot file of another byte order or version %d, which cannot be read!\n", path, version);
+		exit(-1);
+	}
+	if(header[2] != nx || header[3] != ny || header[4] != nz) {
+		printf("%s has %d x %d x %d cells, the lattice %d x %d x %d!\n", path, header[2], header[3], header[4], nx, ny, nz);
+		exit(-1);
+	}
+	const int valueSize = header[5];
+	const int numberOfFileFields = header[6];
+	double geometry[6];
+	const int numberOfGeometryValues = version == 1 ? 3 : 6;
+	if(file.size < offset + numberOfGeometryValues * sizeof(double) + header[7]) {
+		printf("%s: the header is cut off!\n", path);
+		exit(-1);
+	}
+	memcpy(geometry, data + offset, numberOfGeometryValues * sizeof(double));
+	offset += numberOfGeometryValues * sizeof(double);
+	const double * const spacings = geometry + numberOfGeometryValues - 3;
+	const double latticeSpacings[3] = {lattice->latticeSpacingX, lattice->latticeSpacingY, lattice->latticeSpacingRapidity};
+	for(int a = 0; a < 3; ++a) {
+		if(fabs(spacings[a] - latticeSpacings[a]) > 1e-6 * latticeSpacings[a]) {
+			printf("Warning: the spacing of the cells of %s, (%g, %g, %g), is not the one of the lattice\n", path,
+					spacings[0], spacings[1], spacings[2]);
+			break;
+		}
+	}
+	char *fileNames = (char *)malloc(header[7] + 1);
+	memcpy(fileNames, data + offset, header[7]);
+	fileNames[header[7]] = '\0';
+	offset += header[7];
+	const char *fileFields[MAX_SNAPSHOT_FIELDS];
+	int numberOfNames = 0;
+	for(char *name = strtok(fileNames, " "); name && numberOfNames < MAX_SNAPSHOT_FIELDS; name = strtok(NULL, " ")) {
+		fileFields[numberOfNames++] = name;
+	}
+
+	// the first snapshot
+	const size_t ncells = (size_t)nx * ny * nz;
+	double t;
+	uint64_t mask = numberOfFileFields < 64 ? ((uint64_t)1 << numberOfFileFields) - 1 : ~(uint64_t)0;
+	if(file.size < offset + (version == 1 ? 8 : 16)) {
+		printf("%s has no snapshot!\n", path);
+		exit(-1);
+	}
+	memcpy(&t, data + offset, sizeof(t));
+	offset += sizeof(t);
+	if(version > 1) {
+		memcpy(&mask, data + offset, sizeof(mask));
+		offset += sizeof(mask);
+	}
+	if(file.size < offset + __builtin_popcountll(mask) * ncells * valueSize) {
+		printf("%s: the snapshot is cut off!\n", path);
+		exit(-1);
+	}
+
+	for(int f = 0; f < numberOfFields; ++f) {
+		int fileField = -1;
+		for(int g = 0; g < numberOfNames; ++g) if(!strcmp(names[f], fileFields[g])) fileField = g;
+		if(fileField < 0 || !(mask & ((uint64_t)1 << fileField))) {
+			if(!required[f]) continue;
+			printf("%s has no field %s!\n", path, names[f]);
+			exit(-1);
+		}
+		// the fields of the snapshot are one after the other, with x fastest, then y, then eta
+		const char * const values = data + offset + __builtin_popcountll(mask & (((uint64_t)1 << fileField) - 1)) * ncells * valueSize;
+		PRECISION * const field = fields[f];
+		#pragma omp parallel for collapse(2)
+		for(int k = 0; k < nz; ++k) {
+			for(int j = 0; j < ny; ++j) {
+				const char * const row = values + (size_t)nx * (j + (size_t)ny * k) * valueSize;
+				PRECISION * const out = field + columnMajorLinearIndex(2, j+2, k+2, nx+4, ny+4);
+				if(valueSize == sizeof(PRECISION)) memcpy(out, row, nx * sizeof(PRECISION));
+				else if(valueSize == sizeof(float)) {
+					for(int i = 0; i < nx; ++i) {
+						float value;
+						memcpy(&value, row + i * sizeof(float), sizeof(float));
+						out[i] = (PRECISION) value;
+					}
+				}
+				else {
+					for(int i = 0; i < nx; ++i) {
+						double value;
+						memcpy(&value, row + i * sizeof(double), sizeof(double));
+						out[i] = (PRECISION) value;
+					}
+				}
+			}
+		}
+	}
+
+	free(fileNames);
+	unmapInitialConditionFile(&file);
+	return t;
+}
@@ -0,0 +1,31 @@
+/*
+ * InitialConditionFile.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef INITIALCONDITIONFILE_H_
+#define INITIALCONDITIONFILE_H_
+
+#include "../hydro/DynamicalVariables.h"
+
+// The initial condition files are mapped into memory and read into the lattice arrays in parallel.
+//
+// ASCII: numbers separated by white space, numberOfColumns per cell, for the cells with x slowest, then y, then eta
+// fastest, e.g. "x y z e" per line for input/e.dat or the 20 columns of input/Tmunu.dat. The numbers are read as
+// float, like fscanf("%f") did.
+//
+// binary: a snapshot file (see SnapshotFile.h) of the whole lattice, with the fields named as in OutputFields.h.
+// The values of its first snapshot are read. The snapshots written by the hydro with outputFields e, p, ut, ux, uy,
+// un, pitt, ..., pinn, Pi on the whole lattice can be read back as initial conditions.
+
+// read the ASCII file at path: column c of each cell goes to columns[c] (on the lattice with ghost cells), or is
+// skipped if columns[c] is NULL
+void readInitialConditionColumns(const char *path, void * latticeParams, int numberOfColumns, PRECISION * const * columns);
+
+// read the fields with names[f] of the binary file at path to fields[f] (on the lattice with ghost cells); the fields
+// with required[f] = 0 are left unchanged if they are not in the file. Returns the time of the snapshot
+double readInitialConditionSnapshot(const char *path, void * latticeParams, int numberOfFields, const char * const * names,
+		const int * required, PRECISION * const * fields);
+
+#endif /* INITIALCONDITIONFILE_H_ */
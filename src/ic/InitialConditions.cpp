@@ -8,15 +8,18 @@
 #include <math.h> // for math functions
 #include <stdio.h> // for printf
 #include <stdlib.h> //TEMP
+#include <string.h> // for memcpy
 
 #include "../ic/InitialConditions.h"
 #include "../hydro/DynamicalVariables.h"
 #include "../lattice/LatticeParameters.h"
 #include "../ic/InitialConditionParameters.h"
+#include "../ic/InitialConditionFile.h"
 #include "../ic/GlauberModel.h"
 #include "../ic/MonteCarloGlauberModel.h"
 #include "../hydro/HydroParameters.h"
 #include "../eos/EquationOfState.h"
+#include "../hydro/TransportCoefficients.h"
 
 #include <omp.h>
 
@@ -27,450 +30,98 @@
 //* Read in all initial profiles from a single or seperate file
 //*********************************************************************************************************/
 
+//the files are mapped into memory and parsed in parallel straight into the lattice (see InitialConditionFile.h)
+//the previous step of the fluid velocity is set to the same value
+static void setPreviousFluidVelocity(void * latticeParams) {
+    struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
+    size_t bytes = (size_t)lattice->numComputationalLatticePointsX * lattice->numComputationalLatticePointsY
+        * lattice->numComputationalLatticePointsRapidity * sizeof(PRECISION);
+    memcpy(up->ut, u->ut, bytes);
+    memcpy(up->ux, u->ux, bytes);
+    memcpy(up->uy, u->uy, bytes);
+    memcpy(up->un, u->un, bytes);
+}
+
 //this reads all hydro variables from a single file; this way we do not need to fetch the coordinates many times
 //note that the file must contain values for all dissipative currents, even if they are zero !!!
 void setInitialTmunuFromFile(void * latticeParams, void * initCondParams, void * hydroParams, const char *rootDirectory) {
-    struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
-    struct InitialConditionParameters * initCond = (struct InitialConditionParameters *) initCondParams;
-    struct HydroParameters * hydro = (struct HydroParameters *) hydroParams;
-    int nx = lattice->numLatticePointsX;
-    int ny = lattice->numLatticePointsY;
-    int nz = lattice->numLatticePointsRapidity;
-
-    float x, y, z, e_in, p_in, ut_in, ux_in, uy_in, un_in;
-    //#ifdef PIMUNU
-    float pitt_in, pitx_in, pity_in, pitn_in, pixx_in, pixy_in, pixn_in, piyy_in, piyn_in, pinn_in;
-    //#endif
-    //#ifdef PI
-    float Pi_in;
-    //#endif
-    FILE *fileIn;
     char fname[255];
-
     sprintf(fname, "%s/%s", rootDirectory, "/input/Tmunu.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open Tmunu.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f %f\n", &x, &y, &z, &e_in, &p_in, &ut_in, &ux_in, &uy_in, &un_in, &pitt_in, &pitx_in, &pity_in, &pitn_in, &pixx_in, &pixy_in, &pixn_in, &piyy_in, &piyn_in, &pinn_in, &Pi_in);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    e[s] =  (PRECISION) e_in;
-                    //ep[s] = (PRECISION) e_in; //set previous step to same value
-                    p[s] = p_in;
-                    u->ut[s] = ut_in;
-                    u->ux[s] = ux_in;
-                    u->uy[s] = uy_in;
-                    u->un[s] = un_in;
-                    up->ut[s] = ut_in; //set previous step to same value
-                    up->ux[s] = ux_in; //...
-                    up->uy[s] = uy_in;
-                    up->un[s] = un_in;
+    //x y z e p ut ux uy un pitt pitx pity pitn pixx pixy pixn piyy piyn pinn Pi
+    PRECISION * const columns[20] = {NULL, NULL, NULL, e, p, u->ut, u->ux, u->uy, u->un,
 #ifdef PIMUNU
-                    q->pitt[s] = pitt_in;
-                    q->pitx[s] = pitx_in;
-                    q->pity[s] = pity_in;
-                    q->pitn[s] = pitn_in;
-                    q->pixx[s] = pixx_in;
-                    q->pixy[s] = pixy_in;
-                    q->pixn[s] = pixn_in;
-                    q->piyy[s] = piyy_in;
-                    q->piyn[s] = piyn_in;
-                    q->pinn[s] = pinn_in;
+        q->pitt, q->pitx, q->pity, q->pitn, q->pixx, q->pixy, q->pixn, q->piyy, q->piyn, q->pinn,
+#else
+        NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL,
 #endif
 #ifdef PI
-                    q->Pi[s] = Pi_in;
+        q->Pi
+#else
+        NULL
 #endif
-                }
-            }
-        }
-    }
-    fclose(fileIn);
+    };
+    readInitialConditionColumns(fname, latticeParams, 20, columns);
+    setPreviousFluidVelocity(latticeParams);
 }
 
-//this function reads a separate file for every hydrodynamic variable
+//this function reads a separate file for every hydrodynamic variable, "x y z value" per line
 void setInitialTmunuFromFiles(void * latticeParams, void * initCondParams, void * hydroParams, const char *rootDirectory) {
-    struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
-    struct InitialConditionParameters * initCond = (struct InitialConditionParameters *) initCondParams;
-    struct HydroParameters * hydro = (struct HydroParameters *) hydroParams;
-    int nx = lattice->numLatticePointsX;
-    int ny = lattice->numLatticePointsY;
-    int nz = lattice->numLatticePointsRapidity;
-
-    float x, y, z, value;
-    FILE *fileIn;
-    char fname[255];
-
-    //energy density
-    sprintf(fname, "%s/%s", rootDirectory, "/input/e.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open e.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    e[s] =  (PRECISION) value;
-                    //ep[s] = (PRECISION) value;
-                    //printf("e [ %d ] = %f\n", s, e[s]);
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //pressure
-    sprintf(fname, "%s/%s", rootDirectory, "/input/p.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open p.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    p[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //ut
-    sprintf(fname, "%s/%s", rootDirectory, "/input/ut.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open ut.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    u->ut[s] =  (PRECISION) value;
-                    up->ut[s] = (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //ux
-    sprintf(fname, "%s/%s", rootDirectory, "/input/ux.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open ux.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    u->ux[s] =  (PRECISION) value;
-                    up->ux[s] = (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //uy
-    sprintf(fname, "%s/%s", rootDirectory, "/input/uy.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open uy.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    u->uy[s] =  (PRECISION) value;
-                    up->uy[s] = (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //un
-    sprintf(fname, "%s/%s", rootDirectory, "/input/un.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open un.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    u->un[s] =  (PRECISION) value;
-                    up->un[s] = (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
+    const char * const names[] = {"e", "p", "ut", "ux", "uy", "un",
 #ifdef PIMUNU
-    //pitt
-    sprintf(fname, "%s/%s", rootDirectory, "/input/pitt.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open pitt.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->pitt[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //pitx
-    sprintf(fname, "%s/%s", rootDirectory, "/input/pitx.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open pitx.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->pitx[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //pity
-    sprintf(fname, "%s/%s", rootDirectory, "/input/pity.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open pity.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->pity[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //pitn
-    sprintf(fname, "%s/%s", rootDirectory, "/input/pitn.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open pitn.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->pitn[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //pixx
-    sprintf(fname, "%s/%s", rootDirectory, "/input/pixx.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open pixx.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->pixx[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //pixy
-    sprintf(fname, "%s/%s", rootDirectory, "/input/pixy.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open pixy.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->pixy[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //pixn
-    sprintf(fname, "%s/%s", rootDirectory, "/input/pixn.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open pixn.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->pixn[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //piyy
-    sprintf(fname, "%s/%s", rootDirectory, "/input/piyy.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open piyy.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->piyy[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
-
-    //piyn
-    sprintf(fname, "%s/%s", rootDirectory, "/input/piyn.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open piyn.dat!\n");
-    }
-    else
+        "pitt", "pitx", "pity", "pitn", "pixx", "pixy", "pixn", "piyy", "piyn", "pinn",
+#endif
+#ifdef PI
+        "bulk",
+#endif
+    };
+    PRECISION * const variables[] = {e, p, u->ut, u->ux, u->uy, u->un,
+#ifdef PIMUNU
+        q->pitt, q->pitx, q->pity, q->pitn, q->pixx, q->pixy, q->pixn, q->piyy, q->piyn, q->pinn,
+#endif
+#ifdef PI
+        q->Pi,
+#endif
+    };
+    for (int v = 0; v < (int)(sizeof(names) / sizeof(names[0])); ++v)
     {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->piyn[s] =  (PRECISION) value;
-                }
-            }
-        }
+        char fname[255];
+        sprintf(fname, "%s/input/%s.dat", rootDirectory, names[v]);
+        PRECISION * const columns[4] = {NULL, NULL, NULL, variables[v]};
+        readInitialConditionColumns(fname, latticeParams, 4, columns);
     }
-    fclose(fileIn);
+    setPreviousFluidVelocity(latticeParams);
+}
 
-    //pinn
-    sprintf(fname, "%s/%s", rootDirectory, "/input/pinn.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open pinn.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->pinn[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
+//this reads all hydro variables from a binary snapshot file (see SnapshotFile.h), e.g. one written by the hydro
+//the dissipative currents that are not in the file are zero; the time of the file is checked unless it is 0
+void setInitialTmunuFromBinaryFile(void * latticeParams, void * initCondParams, void * hydroParams, const char *rootDirectory) {
+    struct HydroParameters * hydro = (struct HydroParameters *) hydroParams;
+    char fname[255];
+    sprintf(fname, "%s/%s", rootDirectory, "/input/Tmunu.bin");
+    const char * const names[] = {"e", "p", "ut", "ux", "uy", "un",
+#ifdef PIMUNU
+        "pitt", "pitx", "pity", "pitn", "pixx", "pixy", "pixn", "piyy", "piyn", "pinn",
 #endif
 #ifdef PI
-    //bulk
-    sprintf(fname, "%s/%s", rootDirectory, "/input/bulk.dat");
-    fileIn = fopen(fname, "r");
-    if (fileIn == NULL)
-    {
-        printf("Couldn't open bulk.dat!\n");
-    }
-    else
-    {
-        for(int i = 2; i < nx+2; ++i) {
-            for(int j = 2; j < ny+2; ++j) {
-                for(int k = 2; k < nz+2; ++k) {
-                    fscanf(fileIn, "%f %f %f %f\n", &x, &y, &z, &value);
-                    int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
-                    q->Pi[s] =  (PRECISION) value;
-                }
-            }
-        }
-    }
-    fclose(fileIn);
+        "Pi",
+#endif
+    };
+    PRECISION * const variables[] = {e, p, u->ut, u->ux, u->uy, u->un,
+#ifdef PIMUNU
+        q->pitt, q->pitx, q->pity, q->pitn, q->pixx, q->pixy, q->pixn, q->piyy, q->piyn, q->pinn,
 #endif
+#ifdef PI
+        q->Pi,
+#endif
+    };
+    const int numberOfVariables = sizeof(names) / sizeof(names[0]);
+    int required[numberOfVariables];
+    for (int v = 0; v < numberOfVariables; ++v) required[v] = v < 6;
+    double t = readInitialConditionSnapshot(fname, latticeParams, numberOfVariables, names, required, variables);
+    if (t > 0 && fabs(t - hydro->initialProperTimePoint) > 1e-6)
+        printf("Warning: the initial conditions in Tmunu.bin are at tau = %.4f fm, the hydro starts at %.4f fm\n", t,
+            hydro->initialProperTimePoint);
+    setPreviousFluidVelocity(latticeParams);
 }
 
 /*********************************************************************************************************\
@@ -521,7 +172,6 @@ void setPimunuNavierStokesInitialCondition(void * latticeParams, void * initCond
 	PRECISION dx = (PRECISION)(lattice->latticeSpacingX);
 	PRECISION dz = (PRECISION)(lattice->latticeSpacingRapidity);
 
-	PRECISION etabar = (PRECISION)(hydro->shearViscosityToEntropyDensity);
 	PRECISION t = hydro->initialProperTimePoint;
 
 	PRECISION e0 = initCond->initialEnergyDensity;
@@ -532,8 +182,11 @@ void setPimunuNavierStokesInitialCondition(void * latticeParams, void * initCond
 			for(int k = 2; k < nz+2; ++k) {
 				int s = columnMajorLinearIndex(i, j, k, nx+4, ny+4);
 //				double T = pow(e[s]/e0, 0.25);
-				PRECISION T = effectiveTemperature(e[s]);
+				TRANSPORT_COEFFICIENTS tc;
+				getTransportCoefficients(e[s], &tc);
+				PRECISION T = tc.T;
 				if (T == 0) T = 1.e-3;
+				PRECISION etabar = tc.etabar;
 				//PRECISION pinn = -2/(3*t*t*t)*etabar*(e[s]+p[s])/T; //wrong by factor of 2
 				PRECISION pinn = -4.0/(3.0*t*t*t)*etabar*(e[s] + p[s]) / T;
 #ifdef PIMUNU
@@ -549,25 +202,7 @@ void setPimunuNavierStokesInitialCondition(void * latticeParams, void * initCond
 				q->pinn[s] = pinn;
 #endif
 #ifdef PI
-#define A_1 -13.77
-#define A_2 27.55
-#define A_3 13.45
-
-#define LAMBDA_1 0.9
-#define LAMBDA_2 0.25
-#define LAMBDA_3 0.9
-#define LAMBDA_4 0.22
-
-#define SIGMA_1 0.025
-#define SIGMA_2 0.13
-#define SIGMA_3 0.0025
-#define SIGMA_4 0.022
-				PRECISION x = T/1.01355;
-				PRECISION zetabar = A_1*x*x + A_2*x - A_3;
-				if(x > 1.05)
-					zetabar = LAMBDA_1*exp(-(x-1)/SIGMA_1) + LAMBDA_2*exp(-(x-1)/SIGMA_2)+0.001;
-				else if(x < 0.995)
-					zetabar = LAMBDA_3*exp((x-1)/SIGMA_3)+ LAMBDA_4*exp((x-1)/SIGMA_4)+0.03;
+				PRECISION zetabar = tc.zetabar;
 				q->Pi[s] = -zetabar*(e[s]+p[s])/T/t;
 #endif
 			}
@@ -1218,6 +853,11 @@ void setInitialConditions(void * latticeParams, void * initCondParams, void * hy
       setInitialTmunuFromFile(latticeParams, initCondParams, hydroParams, rootDirectory);
       return;
 		}
+    case 12: {
+      printf("Reading initial T ^mu nu from /input/Tmunu.bin \n");
+      setInitialTmunuFromBinaryFile(latticeParams, initCondParams, hydroParams, rootDirectory);
+      return;
+    }
 		default: {
 			printf("Initial condition type not defined. Exiting ...\n");
 			exit(-1);
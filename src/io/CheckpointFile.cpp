@@ -0,0 +1,160 @@
+/*
+ * CheckpointFile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <omp.h>
+
+#include "../io/CheckpointFile.h"
+
+// size of the stdio buffer in front of the file
+#define CHECKPOINT_FILE_BUFFER_SIZE (4 << 20)
+// the blocks are copied from the mapped file in parallel in pieces of this size
+#define CHECKPOINT_COPY_SIZE (1 << 20)
+
+static size_t alignCheckpointOffset(size_t offset) {
+	return (offset + CHECKPOINT_ALIGNMENT - 1) / CHECKPOINT_ALIGNMENT * CHECKPOINT_ALIGNMENT;
+}
+
+static void writeCheckpointBytes(FILE *fp, const char *path, const void *bytes, size_t size) {
+	if(size > 0 && fwrite(bytes, 1, size, fp) != size) {
+		printf("Error writing the checkpoint %s!\n", path);
+		exit(-1);
+	}
+}
+
+// zeros up to the next multiple of CHECKPOINT_ALIGNMENT
+static size_t padCheckpointFile(FILE *fp, const char *path, size_t offset) {
+	static const char zeros[CHECKPOINT_ALIGNMENT] = {0};
+	const size_t aligned = alignCheckpointOffset(offset);
+	writeCheckpointBytes(fp, path, zeros, aligned - offset);
+	return aligned;
+}
+
+void writeCheckpointFile(const char *path, int numberOfBlocks, const void * const * data, const size_t * sizes) {
+	char tmpPath[512];
+	snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+	FILE *fp = fopen(tmpPath, "wb");
+	if(!fp) {
+		printf("Could not open the checkpoint %s!\n", tmpPath);
+		exit(-1);
+	}
+	char *buffer = (char *)malloc(CHECKPOINT_FILE_BUFFER_SIZE);
+	setvbuf(fp, buffer, _IOFBF, CHECKPOINT_FILE_BUFFER_SIZE);
+
+	int32_t header[4];
+	header[0] = CHECKPOINT_VERSION;
+	header[1] = 0x01020304;
+	header[2] = numberOfBlocks;
+	header[3] = 0;
+	writeCheckpointBytes(fp, tmpPath, CHECKPOINT_MAGIC, 8);
+	writeCheckpointBytes(fp, tmpPath, header, sizeof(header));
+	size_t offset = 8 + sizeof(header);
+	for(int b = 0; b < numberOfBlocks; ++b) {
+		const uint64_t size = sizes[b];
+		writeCheckpointBytes(fp, tmpPath, &size, sizeof(size));
+		offset += sizeof(size);
+	}
+	for(int b = 0; b < numberOfBlocks; ++b) {
+		offset = padCheckpointFile(fp, tmpPath, offset);
+		writeCheckpointBytes(fp, tmpPath, data[b], sizes[b]);
+		offset += sizes[b];
+	}
+	padCheckpointFile(fp, tmpPath, offset);
+
+	// the new checkpoint replaces the old one only once all of it is on disk
+	if(fflush(fp) != 0 || fsync(fileno(fp)) != 0) {
+		printf("Error writing the checkpoint %s!\n", tmpPath);
+		exit(-1);
+	}
+	fclose(fp);
+	free(buffer);
+	if(rename(tmpPath, path) != 0) {
+		printf("Could not rename the checkpoint %s to %s!\n", tmpPath, path);
+		exit(-1);
+	}
+	// and the rename is on disk once the directory is
+	char directory[512];
+	snprintf(directory, sizeof(directory), "%s", path);
+	int fd = open(dirname(directory), O_RDONLY);
+	if(fd >= 0) {
+		fsync(fd);
+		close(fd);
+	}
+}
+
+void openCheckpointFile(CHECKPOINT_FILE * const checkpoint, const char *path) {
+	int fd = open(path, O_RDONLY);
+	if(fd < 0) {
+		printf("Couldn't open the checkpoint %s!\n", path);
+		exit(-1);
+	}
+	struct stat st;
+	fstat(fd, &st);
+	checkpoint->path = path;
+	checkpoint->size = st.st_size;
+	const size_t headerSize = 8 + 4 * sizeof(int32_t);
+	void *data = checkpoint->size >= headerSize ? mmap(NULL, checkpoint->size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+	close(fd);
+	if(data == MAP_FAILED) {
+		printf("Couldn't map the checkpoint %s into memory!\n", path);
+		exit(-1);
+	}
+	// the blocks are read once, from the beginning to the end
+	madvise(data, checkpoint->size, MADV_SEQUENTIAL);
+	madvise(data, checkpoint->size, MADV_WILLNEED);
+	checkpoint->data = (const char *)data;
+
+	int32_t header[4];
+	memcpy(header, checkpoint->data + 8, sizeof(header));
+	if(memcmp(checkpoint->data, CHECKPOINT_MAGIC, 8) || header[0] != CHECKPOINT_VERSION || header[1] != 0x01020304
+			|| header[2] < 0 || headerSize + header[2] * sizeof(uint64_t) > checkpoint->size) {
+		printf("%s is not a checkpoint of this version of the code!\n", path);
+		exit(-1);
+	}
+	checkpoint->numberOfBlocks = header[2];
+	checkpoint->sizes = (const uint64_t *)(checkpoint->data + headerSize);
+	checkpoint->offsets = (size_t *)malloc(checkpoint->numberOfBlocks * sizeof(size_t));
+	size_t offset = headerSize + checkpoint->numberOfBlocks * sizeof(uint64_t);
+	for(int b = 0; b < checkpoint->numberOfBlocks && offset <= checkpoint->size; ++b) {
+		offset = alignCheckpointOffset(offset);
+		checkpoint->offsets[b] = offset;
+		offset += checkpoint->sizes[b];
+	}
+	if(offset > checkpoint->size) {
+		printf("The checkpoint %s is truncated!\n", path);
+		exit(-1);
+	}
+}
+
+void readCheckpointBlock(const CHECKPOINT_FILE * const checkpoint, int b, void *data, size_t size) {
+	if(b >= checkpoint->numberOfBlocks || checkpoint->sizes[b] != size) {
+		printf("The checkpoint %s was written by a run with a different configuration (block %d)!\n", checkpoint->path, b);
+		exit(-1);
+	}
+	const char * const from = checkpoint->data + checkpoint->offsets[b];
+	char * const to = (char *)data;
+	const long pieces = (size + CHECKPOINT_COPY_SIZE - 1) / CHECKPOINT_COPY_SIZE;
+	#pragma omp parallel for if(pieces > 1)
+	for(long i = 0; i < pieces; ++i) {
+		const size_t begin = i * CHECKPOINT_COPY_SIZE;
+		const size_t length = size - begin < CHECKPOINT_COPY_SIZE ? size - begin : CHECKPOINT_COPY_SIZE;
+		memcpy(to + begin, from + begin, length);
+	}
+}
+
+void closeCheckpointFile(CHECKPOINT_FILE * const checkpoint) {
+	munmap((void *)checkpoint->data, checkpoint->size);
+	free(checkpoint->offsets);
+	checkpoint->data = NULL;
+	checkpoint->offsets = NULL;
+}
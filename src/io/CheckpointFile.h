@@ -0,0 +1,53 @@
+/*
+ * CheckpointFile.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef CHECKPOINTFILE_H_
+#define CHECKPOINTFILE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A checkpoint holds the state of a run as a list of blocks of memory, which are written to the file one after the
+// other and copied back to the same places when the run is resumed. What the blocks are is up to the writer of the
+// checkpoint (see HydroPlugin.cpp); the file only knows their sizes.
+//
+// format: the header
+//	char[8]  magic "CPUVHCKP"
+//	int32    version
+//	int32    0x01020304, written in native byte order
+//	int32    number of blocks
+//	int32    0
+//	uint64   size of each block [bytes]
+// is followed by the blocks, each starting at a multiple of CHECKPOINT_ALIGNMENT bytes from the beginning of the file,
+// so that each is on pages of its own when the file is mapped into memory
+#define CHECKPOINT_MAGIC "CPUVHCKP"
+#define CHECKPOINT_VERSION 1
+#define CHECKPOINT_ALIGNMENT 4096
+
+// write the blocks data[b] of sizes[b] bytes to path. The file is written as path.tmp and renamed to path once it
+// is on disk, so that path always holds a complete checkpoint, the previous one until the new one is written
+void writeCheckpointFile(const char *path, int numberOfBlocks, const void * const * data, const size_t * sizes);
+
+// a checkpoint mapped into memory
+typedef struct
+{
+	const char *path;
+	const char *data;
+	size_t size;
+	int numberOfBlocks;
+	const uint64_t *sizes;
+	size_t *offsets; // of the blocks in the file
+} CHECKPOINT_FILE;
+
+void openCheckpointFile(CHECKPOINT_FILE * const checkpoint, const char *path);
+
+// copy block b of the checkpoint to data; the run is stopped if the block is not of size bytes, i.e. the checkpoint
+// was not written by a run with the same configuration
+void readCheckpointBlock(const CHECKPOINT_FILE * const checkpoint, int b, void *data, size_t size);
+
+void closeCheckpointFile(CHECKPOINT_FILE * const checkpoint);
+
+#endif /* CHECKPOINTFILE_H_ */
@@ -0,0 +1,103 @@
+/*
+ * OutputFields.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <string.h>
+
+#include "../io/OutputFields.h"
+#include "../lattice/LatticeParameters.h"
+#include "../hydro/DynamicalVariables.h"
+#include "../eos/EquationOfState.h"
+
+enum {
+	OUTPUT_E, OUTPUT_P, OUTPUT_T, OUTPUT_UT, OUTPUT_UX, OUTPUT_UY, OUTPUT_UN, OUTPUT_THETA,
+#ifdef PIMUNU
+	OUTPUT_PITT, OUTPUT_PITX, OUTPUT_PITY, OUTPUT_PITN, OUTPUT_PIXX, OUTPUT_PIXY, OUTPUT_PIXN, OUTPUT_PIYY, OUTPUT_PIYN,
+	OUTPUT_PINN,
+#endif
+#ifdef PI
+	OUTPUT_BULK,
+#endif
+	NUMBER_OUTPUT_FIELDS
+};
+
+static const char * const outputFieldNames[NUMBER_OUTPUT_FIELDS] = {
+	"e", "p", "T", "ut", "ux", "uy", "un", "theta",
+#ifdef PIMUNU
+	"pitt", "pitx", "pity", "pitn", "pixx", "pixy", "pixn", "piyy", "piyn", "pinn",
+#endif
+#ifdef PI
+	"Pi",
+#endif
+};
+
+int outputFieldIndex(const char *name) {
+	for(int f = 0; f < NUMBER_OUTPUT_FIELDS; ++f) if(!strcmp(name, outputFieldNames[f])) return f;
+	return -1;
+}
+
+// the array of a stored field, NULL for the derived ones
+static const PRECISION * storedOutputField(int field) {
+	switch(field) {
+	case OUTPUT_E: return e;
+	case OUTPUT_P: return p;
+	case OUTPUT_UT: return u->ut;
+	case OUTPUT_UX: return u->ux;
+	case OUTPUT_UY: return u->uy;
+	case OUTPUT_UN: return u->un;
+#ifdef PIMUNU
+	case OUTPUT_PITT: return q->pitt;
+	case OUTPUT_PITX: return q->pitx;
+	case OUTPUT_PITY: return q->pity;
+	case OUTPUT_PITN: return q->pitn;
+	case OUTPUT_PIXX: return q->pixx;
+	case OUTPUT_PIXY: return q->pixy;
+	case OUTPUT_PIXN: return q->pixn;
+	case OUTPUT_PIYY: return q->piyy;
+	case OUTPUT_PIYN: return q->piyn;
+	case OUTPUT_PINN: return q->pinn;
+#endif
+#ifdef PI
+	case OUTPUT_BULK: return q->Pi;
+#endif
+	default: return NULL;
+	}
+}
+
+void evaluateOutputField(int field, const SNAPSHOT_FILE * const snapshot, void * latticeParams, double t, double dt,
+		PRECISION * const values) {
+	const PRECISION * const stored = storedOutputField(field);
+	if(stored) {
+		gatherSnapshotField(snapshot, stored, values);
+		return;
+	}
+	struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
+	const int ncx = lattice->numComputationalLatticePointsX;
+	const int ncxy = ncx * lattice->numComputationalLatticePointsY;
+	const PRECISION facX = 1/lattice->latticeSpacingX/2;
+	const PRECISION facY = 1/lattice->latticeSpacingY/2;
+	const PRECISION facZ = 1/lattice->latticeSpacingRapidity/2;
+	const PRECISION tInv = 1/t;
+	const PRECISION dtInv = dt > 0 ? 1/dt : 0;
+	const int nx = snapshot->nx, ny = snapshot->ny, nz = snapshot->nz;
+	#pragma omp parallel for collapse(2)
+	for(int k = 0; k < nz; ++k) {
+		for(int j = 0; j < ny; ++j) {
+			PRECISION * const out = values + (size_t)nx * (j + (size_t)ny * k);
+			for(int i = 0; i < nx; ++i) {
+				const int s = snapshotLatticeIndex(snapshot, i, j, k);
+				if(field == OUTPUT_T) {
+					out[i] = effectiveTemperature(e[s]);
+				}
+				else {
+					// theta = d_mu u^mu + u^tau/tau with central differences, and the time derivative from the previous step
+					const PRECISION dxux = (u->ux[s+1] - u->ux[s-1]) * facX;
+					const PRECISION dyuy = (u->uy[s+ncx] - u->uy[s-ncx]) * facY;
+					const PRECISION dnun = (u->un[s+ncxy] - u->un[s-ncxy]) * facZ;
+					out[i] = dnun + dxux + dyuy + u->ut[s]*tInv + dtInv*(u->ut[s] - up->ut[s]);
+				}
+			}
+		}
+	}
+}
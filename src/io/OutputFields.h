@@ -0,0 +1,30 @@
+/*
+ * OutputFields.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OUTPUTFIELDS_H_
+#define OUTPUTFIELDS_H_
+
+#include "../hydro/DynamicalVariables.h"
+#include "../io/SnapshotFile.h"
+
+// the fields that can be listed in outputFields of output.properties:
+//	e, p            energy density and pressure [fm^-4]
+//	T               temperature [fm^-1], from the energy density with the equation of state
+//	ut, ux, uy, un  fluid velocity u^mu [1, 1, 1, fm^-1]
+//	theta           expansion rate d_mu u^mu [fm^-1], discretized like in the source terms
+//	pitt, ..., pinn shear stress pi^{mu nu} [fm^-4] (with PIMUNU)
+//	Pi              bulk pressure [fm^-4] (with PI)
+// the stored variables are copied; the derived ones are evaluated in the written cells only
+
+// index of the field name, -1 if there is no such field
+int outputFieldIndex(const char *name);
+
+// the values of the field with index field at time t in the cells of snapshot, in the order of the file. theta needs
+// the fluid velocity of the previous step, up, at t - dt; dt = 0 leaves out the time derivative (at the initial time)
+void evaluateOutputField(int field, const SNAPSHOT_FILE * const snapshot, void * latticeParams, double t, double dt,
+		PRECISION * const values);
+
+#endif /* OUTPUTFIELDS_H_ */
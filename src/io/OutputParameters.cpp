@@ -0,0 +1,114 @@
+/*
+ * OutputParameters.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <float.h>
+
+#include "../io/OutputParameters.h"
+#include "../util/Properties.h"
+
+int outputFrequency;
+int outputFormat;
+int outputBuffers;
+int numberOfOutputFields;
+const char *outputFields[MAX_OUTPUT_FIELDS];
+int numberOfOutputIntervals;
+double outputIntervals[MAX_OUTPUT_FIELDS];
+double outputXRange[2];
+double outputYRange[2];
+double outputRapidityRange[2];
+int outputDecimation;
+int freezeoutFrequency;
+double freezeoutThreadFraction;
+int freezeoutCellTime;
+int freezeoutFormat;
+int checkpointFrequency;
+
+static const char * const defaultOutputFields[] = {"e", "ux", "uy", "ut"};
+
+// a range [min, max]; the whole axis if it is not set
+static void getRangeProperty(config_t *cfg, const char* propName, double *range) {
+	// one value more than a range, to tell a longer array from a range
+	double values[3];
+	int n = getDoubleArrayProperty(cfg, propName, values, 3);
+	if(n == 0) {
+		range[0] = -DBL_MAX;
+		range[1] = DBL_MAX;
+		return;
+	}
+	if(n != 2 || values[0] > values[1]) {
+		printf("%s must be a range [min, max] with min <= max!\n", propName);
+		exit(-1);
+	}
+	range[0] = values[0];
+	range[1] = values[1];
+}
+
+void loadOutputParameters(config_t *cfg, const char* configDirectory, void * params) {
+	// Read the file
+	char fname[255];
+	sprintf(fname, "%s/%s", configDirectory, "output.properties");
+	if (!config_read_file(cfg, fname)) {
+		fprintf(stderr, "No configuration file  %s found for output parameters - %s.\n", fname, config_error_text(cfg));
+		fprintf(stderr, "Using default output configuration parameters.\n");
+	}
+
+	getIntegerProperty(cfg, "outputFrequency", &outputFrequency, 10);
+	getIntegerProperty(cfg, "outputFormat", &outputFormat, 2);
+	getIntegerProperty(cfg, "outputBuffers", &outputBuffers, 2);
+	numberOfOutputFields = getStringArrayProperty(cfg, "outputFields", outputFields, MAX_OUTPUT_FIELDS);
+	if(numberOfOutputFields == 0) {
+		numberOfOutputFields = sizeof(defaultOutputFields) / sizeof(defaultOutputFields[0]);
+		for(int i = 0; i < numberOfOutputFields; ++i) outputFields[i] = defaultOutputFields[i];
+	}
+	numberOfOutputIntervals = getDoubleArrayProperty(cfg, "outputIntervals", outputIntervals, MAX_OUTPUT_FIELDS);
+	for(int i = 0; i < numberOfOutputIntervals; ++i) {
+		if(outputIntervals[i] < 0) {
+			printf("outputIntervals[%d] = %g must not be negative!\n", i, outputIntervals[i]);
+			exit(-1);
+		}
+	}
+	getRangeProperty(cfg, "outputXRange", outputXRange);
+	getRangeProperty(cfg, "outputYRange", outputYRange);
+	getRangeProperty(cfg, "outputRapidityRange", outputRapidityRange);
+	getIntegerProperty(cfg, "outputDecimation", &outputDecimation, 1);
+	getIntegerProperty(cfg, "freezeoutFrequency", &freezeoutFrequency, 10);
+	getDoubleProperty(cfg, "freezeoutThreadFraction", &freezeoutThreadFraction, 0.25);
+	getIntegerProperty(cfg, "freezeoutCellTime", &freezeoutCellTime, 0);
+	getIntegerProperty(cfg, "freezeoutFormat", &freezeoutFormat, 0);
+	getIntegerProperty(cfg, "checkpointFrequency", &checkpointFrequency, 0);
+
+	struct OutputParameters * output = (struct OutputParameters *) params;
+	output->outputFrequency = outputFrequency > 0 ? outputFrequency : 1;
+	output->outputFormat = outputFormat;
+	output->outputBuffers = outputBuffers;
+	output->numberOfFields = numberOfOutputFields;
+	// the strings belong to cfg, which is destroyed after loading
+	for(int i = 0; i < numberOfOutputFields; ++i) {
+		strncpy(output->fields[i], outputFields[i], MAX_OUTPUT_FIELD_NAME_LENGTH - 1);
+		output->fields[i][MAX_OUTPUT_FIELD_NAME_LENGTH - 1] = '\0';
+		// the fields without an interval are written every outputFrequency steps
+		output->intervals[i] = i < numberOfOutputIntervals ? outputIntervals[i] : 0;
+	}
+	for(int k = 0; k < 2; ++k) {
+		output->xRange[k] = outputXRange[k];
+		output->yRange[k] = outputYRange[k];
+		output->rapidityRange[k] = outputRapidityRange[k];
+	}
+	output->decimation = outputDecimation > 0 ? outputDecimation : 1;
+	// the finder searches windows of freezeoutFrequency steps, which the ring of the history holds
+	if(freezeoutFrequency < 1) {
+		printf("freezeoutFrequency = %d in %s must be at least 1!\n", freezeoutFrequency, fname);
+		exit(-1);
+	}
+	output->freezeoutFrequency = freezeoutFrequency;
+	output->freezeoutThreadFraction = freezeoutThreadFraction < 0 ? 0 : freezeoutThreadFraction > 1 ? 1 : freezeoutThreadFraction;
+	output->freezeoutCellTime = freezeoutCellTime;
+	output->freezeoutFormat = freezeoutFormat;
+	output->checkpointFrequency = checkpointFrequency > 0 ? checkpointFrequency : 0;
+}
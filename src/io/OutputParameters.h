@@ -0,0 +1,47 @@
+/*
+ * OutputParameters.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef OUTPUTPARAMETERS_H_
+#define OUTPUTPARAMETERS_H_
+
+#include <libconfig.h>
+
+#define MAX_OUTPUT_FIELDS 32
+#define MAX_OUTPUT_FIELD_NAME_LENGTH 16
+
+struct OutputParameters
+{
+	// steps between the outputs of the fields without an interval, and the lines of the log
+	int outputFrequency;
+	// format of the snapshots of the fluid (SNAPSHOT_FORMAT_* in SnapshotFile.h) and the number of staging buffers
+	// of the output thread
+	int outputFormat;
+	int outputBuffers;
+	// the output plan: the fields written (see OutputFields.h), and for each the interval in tau between its
+	// outputs [fm], 0 for every outputFrequency steps
+	int numberOfFields;
+	char fields[MAX_OUTPUT_FIELDS][MAX_OUTPUT_FIELD_NAME_LENGTH];
+	double intervals[MAX_OUTPUT_FIELDS];
+	// the cells written: those in the ranges [min, max] of x [fm], y [fm] and eta, and of them every
+	// decimation-th along each axis, counted from the center of the lattice
+	double xRange[2], yRange[2], rapidityRange[2];
+	int decimation;
+	// steps between the searches of the freezeout finder
+	int freezeoutFrequency;
+	// fraction of the OpenMP threads that search the freezeout surface in the background while the others evolve
+	// the hydro
+	double freezeoutThreadFraction;
+	// write the proper times of the surface elements rounded (down) to the step size
+	int freezeoutCellTime;
+	// format of the freezeout surface file (FREEZEOUT_FORMAT_* in FreezeoutSurfaceFile.h)
+	int freezeoutFormat;
+	// steps between the checkpoints of the state of the run, from which it can be resumed; 0 for none
+	int checkpointFrequency;
+};
+
+void loadOutputParameters(config_t *cfg, const char* configDirectory, void * params);
+
+#endif /* OUTPUTPARAMETERS_H_ */
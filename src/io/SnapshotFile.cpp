@@ -0,0 +1,325 @@
+/*
+ * SnapshotFile.cpp
+ *
+ *  Created on: Oct 19, 2026
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <omp.h>
+
+#include "../io/SnapshotFile.h"
+#include "../lattice/LatticeParameters.h"
+#include "../hydro/DynamicalVariables.h"
+
+// size of the stdio buffer in front of the file, so that the filesystem sees large writes
+#define SNAPSHOT_FILE_BUFFER_SIZE (4 << 20)
+
+// the cells of an axis of n lattice points with spacing d that are in range and on the decimation grid through the
+// center: returns their number, and the index and the position of the first of them
+static int selectSnapshotCells(int n, double d, const double * const range, int decimation, int *first, double *x0) {
+	const int center = (n - 1) / 2;
+	int count = 0;
+	for(int i = 0; i < n; ++i) {
+		double x = (i - (n-1)/2.)*d;
+		// a range inside a cell selects the cell
+		if(x < range[0] - 0.5*d*(1 + 1e-9) || x > range[1] + 0.5*d*(1 + 1e-9)) continue;
+		if(((i - center) % decimation + decimation) % decimation != 0) continue;
+		if(count == 0) {
+			*first = i;
+			*x0 = x;
+		}
+		count++;
+	}
+	return count;
+}
+
+void initializeSnapshotFile(SNAPSHOT_FILE * const snapshot, void * latticeParams, int numberOfFields, const char * const * names,
+		const double * const xRange, const double * const yRange, const double * const rapidityRange, int decimation) {
+	struct LatticeParameters * lattice = (struct LatticeParameters *) latticeParams;
+	const int n[3] = {lattice->numLatticePointsX, lattice->numLatticePointsY, lattice->numLatticePointsRapidity};
+	const double d[3] = {lattice->latticeSpacingX, lattice->latticeSpacingY, lattice->latticeSpacingRapidity};
+	const double * const ranges[3] = {xRange, yRange, rapidityRange};
+	const char * const axes[3] = {"x", "y", "eta"};
+	int count[3];
+	double x0[3];
+	for(int a = 0; a < 3; ++a) {
+		count[a] = selectSnapshotCells(n[a], d[a], ranges[a], decimation, &snapshot->first[a], &x0[a]);
+		if(count[a] == 0) {
+			printf("No cells of the lattice along %s are in the output range [%g, %g]!\n", axes[a], ranges[a][0], ranges[a][1]);
+			exit(-1);
+		}
+		// a single cell along an axis is written with the spacing of the lattice
+		snapshot->stride[a] = count[a] > 1 ? decimation : 1;
+	}
+	snapshot->nx = count[0];
+	snapshot->ny = count[1];
+	snapshot->nz = count[2];
+	snapshot->latticeNx = n[0];
+	snapshot->latticeNy = n[1];
+	snapshot->x0 = x0[0];
+	snapshot->y0 = x0[1];
+	snapshot->z0 = x0[2];
+	snapshot->dx = snapshot->stride[0] * d[0];
+	snapshot->dy = snapshot->stride[1] * d[1];
+	snapshot->dz = snapshot->stride[2] * d[2];
+	snapshot->numberOfFields = numberOfFields;
+	for(int i = 0; i < numberOfFields; ++i) snapshot->names[i] = names[i];
+	snapshot->file = NULL;
+	snapshot->buffer = NULL;
+	snapshot->numberOfSnapshots = 0;
+}
+
+void snapshotFilePath(char *path, const char *directory, int format, double t) {
+	if(format == SNAPSHOT_FORMAT_BINARY) sprintf(path, "%s/snapshot_%.3f.bin", directory, t);
+	else sprintf(path, "%s/snapshots.bin", directory);
+}
+
+static void writeBytes(SNAPSHOT_FILE * const snapshot, const void *bytes, size_t size) {
+	if(fwrite(bytes, 1, size, snapshot->file) != size) {
+		printf("Error writing the snapshot file!\n");
+		exit(-1);
+	}
+}
+
+// reopen the file of a checkpointed run, cut off after offset bytes, to append the snapshots that follow
+static void resumeSnapshotFile(SNAPSHOT_FILE * const snapshot, const char *path, long offset) {
+	struct stat st;
+	if(stat(path, &st) != 0 || st.st_size < offset || truncate(path, offset) != 0) {
+		printf("The snapshot file %s does not have the %ld bytes it had at the checkpoint!\n", path, offset);
+		exit(-1);
+	}
+	snapshot->file = fopen(path, "ab");
+	if(!snapshot->file) {
+		printf("Could not open the snapshot file %s!\n", path);
+		exit(-1);
+	}
+	snapshot->buffer = (char *)malloc(SNAPSHOT_FILE_BUFFER_SIZE);
+	setvbuf(snapshot->file, snapshot->buffer, _IOFBF, SNAPSHOT_FILE_BUFFER_SIZE);
+}
+
+void openSnapshotFile(SNAPSHOT_FILE * const snapshot, const char *path) {
+	snapshot->file = fopen(path, "wb");
+	if(!snapshot->file) {
+		printf("Could not open the snapshot file %s!\n", path);
+		exit(-1);
+	}
+	snapshot->buffer = (char *)malloc(SNAPSHOT_FILE_BUFFER_SIZE);
+	setvbuf(snapshot->file, snapshot->buffer, _IOFBF, SNAPSHOT_FILE_BUFFER_SIZE);
+
+	char names[MAX_SNAPSHOT_FIELDS * 16] = "";
+	for(int i = 0; i < snapshot->numberOfFields; ++i) {
+		if(i > 0) strcat(names, " ");
+		strncat(names, snapshot->names[i], 15);
+	}
+	int32_t header[8];
+	header[0] = SNAPSHOT_BINARY_VERSION;
+	header[1] = 0x01020304;
+	header[2] = snapshot->nx;
+	header[3] = snapshot->ny;
+	header[4] = snapshot->nz;
+	header[5] = sizeof(PRECISION);
+	header[6] = snapshot->numberOfFields;
+	header[7] = strlen(names) + 1;
+	const double geometry[6] = {snapshot->x0, snapshot->y0, snapshot->z0, snapshot->dx, snapshot->dy, snapshot->dz};
+	writeBytes(snapshot, SNAPSHOT_BINARY_MAGIC, 8);
+	writeBytes(snapshot, header, sizeof(header));
+	writeBytes(snapshot, geometry, sizeof(geometry));
+	writeBytes(snapshot, names, header[7]);
+}
+
+size_t snapshotCells(const SNAPSHOT_FILE * const snapshot) {
+	return (size_t)snapshot->nx * snapshot->ny * snapshot->nz;
+}
+
+void gatherSnapshotField(const SNAPSHOT_FILE * const snapshot, const PRECISION * const field, PRECISION * const values) {
+	const int nx = snapshot->nx, ny = snapshot->ny, nz = snapshot->nz;
+	const int stride = snapshot->stride[0];
+	#pragma omp parallel for collapse(2)
+	for(int k = 0; k < nz; ++k) {
+		for(int j = 0; j < ny; ++j) {
+			const PRECISION * const row = field + snapshotLatticeIndex(snapshot, 0, j, k);
+			PRECISION * const out = values + (size_t)nx * (j + (size_t)ny * k);
+			// without decimation the rows of x are contiguous on the lattice with ghost cells too
+			if(stride == 1) memcpy(out, row, nx * sizeof(PRECISION));
+			else for(int i = 0; i < nx; ++i) out[i] = row[i * stride];
+		}
+	}
+}
+
+void writeSnapshot(SNAPSHOT_FILE * const snapshot, double t, uint64_t mask, const PRECISION * const values) {
+	const int64_t fields = mask;
+	writeBytes(snapshot, &t, sizeof(t));
+	writeBytes(snapshot, &fields, sizeof(fields));
+	writeBytes(snapshot, values, __builtin_popcountll(mask) * snapshotCells(snapshot) * sizeof(PRECISION));
+	// a snapshot is complete in the file once it is written, so that it can be read while the hydro runs
+	fflush(snapshot->file);
+	snapshot->numberOfSnapshots++;
+}
+
+void closeSnapshotFile(SNAPSHOT_FILE * const snapshot) {
+	if(snapshot->file) fclose(snapshot->file);
+	free(snapshot->buffer);
+	snapshot->file = NULL;
+	snapshot->buffer = NULL;
+}
+
+// the fields in mask of a snapshot, each in its own ASCII file <name>_<tau>.dat, the way output() in FileIO.cpp
+// writes them
+static void writeSnapshotAscii(const SNAPSHOT_FILE * const snapshot, const char *directory, double t, uint64_t mask,
+		const PRECISION * const values) {
+	const int nx = snapshot->nx, ny = snapshot->ny, nz = snapshot->nz;
+	const PRECISION *v = values;
+	for(int f = 0; f < snapshot->numberOfFields; ++f) {
+		if(!(mask & ((uint64_t)1 << f))) continue;
+		char fname[255];
+		sprintf(fname, "%s/%s_%.3f.dat", directory, snapshot->names[f], t);
+		FILE *fp = fopen(fname, "w");
+		if(!fp) {
+			printf("Could not open the output file %s!\n", fname);
+			exit(-1);
+		}
+		setvbuf(fp, NULL, _IOFBF, SNAPSHOT_FILE_BUFFER_SIZE);
+		for(int k = 0; k < nz; ++k) {
+			double z = snapshot->z0 + k*snapshot->dz;
+			for(int j = 0; j < ny; ++j) {
+				double y = snapshot->y0 + j*snapshot->dy;
+				for(int i = 0; i < nx; ++i) {
+					double x = snapshot->x0 + i*snapshot->dx;
+					fprintf(fp, "%.3f\t%.3f\t%.3f\t%.8f\n",x,y,z,*v++);
+				}
+			}
+		}
+		fclose(fp);
+	}
+}
+
+static void * snapshotWriterThread(void *arg) {
+	SNAPSHOT_WRITER * const writer = (SNAPSHOT_WRITER *)arg;
+	pthread_mutex_lock(&writer->mutex);
+	while(true) {
+		while(!writer->count && !writer->quit) pthread_cond_wait(&writer->cond, &writer->mutex);
+		if(!writer->count) break;
+		const int slot = writer->head;
+		pthread_mutex_unlock(&writer->mutex);
+
+		const double t = writer->times[slot];
+		const uint64_t mask = writer->masks[slot];
+		if(writer->format == SNAPSHOT_FORMAT_ASCII) {
+			writeSnapshotAscii(&writer->file, writer->directory, t, mask, writer->buffers[slot]);
+			writer->file.numberOfSnapshots++;
+		}
+		else if(writer->format == SNAPSHOT_FORMAT_BINARY) {
+			char path[255];
+			snapshotFilePath(path, writer->directory, writer->format, t);
+			openSnapshotFile(&writer->file, path);
+			writeSnapshot(&writer->file, t, mask, writer->buffers[slot]);
+			closeSnapshotFile(&writer->file);
+		}
+		else {
+			writeSnapshot(&writer->file, t, mask, writer->buffers[slot]);
+		}
+
+		pthread_mutex_lock(&writer->mutex);
+		writer->head = (writer->head + 1) % writer->numberOfBuffers;
+		writer->count--;
+		pthread_cond_broadcast(&writer->cond);
+	}
+	pthread_mutex_unlock(&writer->mutex);
+	return NULL;
+}
+
+// a SNAPSHOT_FORMAT_BINARY_APPEND file is opened, a new one, or the one of a checkpointed run if resumeOffset >= 0
+static void startWriter(SNAPSHOT_WRITER * const writer, const SNAPSHOT_FILE * const file, int format, const char *directory,
+		double t0, int numberOfBuffers, long resumeOffset) {
+	writer->file = *file;
+	writer->format = format;
+	writer->directory = directory;
+	writer->numberOfBuffers = numberOfBuffers > 0 ? numberOfBuffers : 1;
+	writer->buffers = (PRECISION **)malloc(writer->numberOfBuffers * sizeof(PRECISION *));
+	writer->times = (double *)malloc(writer->numberOfBuffers * sizeof(double));
+	writer->masks = (uint64_t *)malloc(writer->numberOfBuffers * sizeof(uint64_t));
+	for(int i = 0; i < writer->numberOfBuffers; ++i) {
+		writer->buffers[i] = (PRECISION *)malloc(file->numberOfFields * snapshotCells(file) * sizeof(PRECISION));
+		if(!writer->buffers[i]) {
+			printf("Could not allocate the snapshot buffers!\n");
+			exit(-1);
+		}
+	}
+	writer->head = 0;
+	writer->count = 0;
+	writer->quit = 0;
+	writer->waitTime = 0;
+	if(format == SNAPSHOT_FORMAT_BINARY_APPEND) {
+		char path[255];
+		snapshotFilePath(path, directory, format, t0);
+		if(resumeOffset >= 0) resumeSnapshotFile(&writer->file, path, resumeOffset);
+		else openSnapshotFile(&writer->file, path);
+	}
+	pthread_mutex_init(&writer->mutex, NULL);
+	pthread_cond_init(&writer->cond, NULL);
+	if(pthread_create(&writer->thread, NULL, snapshotWriterThread, writer) != 0) {
+		printf("Could not start the snapshot writer thread!\n");
+		exit(-1);
+	}
+}
+
+void startSnapshotWriter(SNAPSHOT_WRITER * const writer, const SNAPSHOT_FILE * const file, int format, const char *directory,
+		double t0, int numberOfBuffers) {
+	startWriter(writer, file, format, directory, t0, numberOfBuffers, -1);
+}
+
+void resumeSnapshotWriter(SNAPSHOT_WRITER * const writer, const SNAPSHOT_FILE * const file, int format, const char *directory,
+		double t0, int numberOfBuffers, long offset, long numberOfSnapshots) {
+	startWriter(writer, file, format, directory, t0, numberOfBuffers, offset);
+	writer->file.numberOfSnapshots = numberOfSnapshots;
+}
+
+long snapshotWriterOffset(SNAPSHOT_WRITER * const writer) {
+	double waitStart = omp_get_wtime();
+	pthread_mutex_lock(&writer->mutex);
+	while(writer->count) pthread_cond_wait(&writer->cond, &writer->mutex);
+	pthread_mutex_unlock(&writer->mutex);
+	writer->waitTime += omp_get_wtime() - waitStart;
+	// each snapshot is flushed to the file once it is written
+	return writer->format == SNAPSHOT_FORMAT_BINARY_APPEND ? ftell(writer->file.file) : 0;
+}
+
+PRECISION * acquireSnapshotBuffer(SNAPSHOT_WRITER * const writer) {
+	double waitStart = omp_get_wtime();
+	pthread_mutex_lock(&writer->mutex);
+	while(writer->count == writer->numberOfBuffers) pthread_cond_wait(&writer->cond, &writer->mutex);
+	const int slot = (writer->head + writer->count) % writer->numberOfBuffers;
+	pthread_mutex_unlock(&writer->mutex);
+	writer->waitTime += omp_get_wtime() - waitStart;
+	// the free buffer is not touched by the writer until it is queued
+	return writer->buffers[slot];
+}
+
+void queueSnapshot(SNAPSHOT_WRITER * const writer, double t, uint64_t mask) {
+	pthread_mutex_lock(&writer->mutex);
+	const int slot = (writer->head + writer->count) % writer->numberOfBuffers;
+	writer->times[slot] = t;
+	writer->masks[slot] = mask;
+	writer->count++;
+	pthread_cond_broadcast(&writer->cond);
+	pthread_mutex_unlock(&writer->mutex);
+}
+
+void finishSnapshotWriter(SNAPSHOT_WRITER * const writer) {
+	pthread_mutex_lock(&writer->mutex);
+	writer->quit = 1;
+	pthread_cond_broadcast(&writer->cond);
+	pthread_mutex_unlock(&writer->mutex);
+	pthread_join(writer->thread, NULL);
+	pthread_mutex_destroy(&writer->mutex);
+	pthread_cond_destroy(&writer->cond);
+	closeSnapshotFile(&writer->file);
+	for(int i = 0; i < writer->numberOfBuffers; ++i) free(writer->buffers[i]);
+	free(writer->buffers);
+	free(writer->times);
+	free(writer->masks);
+}
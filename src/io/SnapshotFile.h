@@ -0,0 +1,129 @@
+/*
+ * SnapshotFile.h
+ *
+ *  Created on: Oct 19, 2026
+ */
+
+#ifndef SNAPSHOTFILE_H_
+#define SNAPSHOTFILE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "../hydro/DynamicalVariables.h"
+
+// formats of the snapshots of the fluid (outputFormat in output.properties)
+#define SNAPSHOT_FORMAT_ASCII 0 // one ASCII file per field and output time, e_<tau>.dat, "x y z value" per cell
+#define SNAPSHOT_FORMAT_BINARY 1 // one binary file with the fields of an output time, snapshot_<tau>.bin
+#define SNAPSHOT_FORMAT_BINARY_APPEND 2 // one binary file per run, snapshots.bin, a snapshot appended per output time
+
+// binary format: the header
+//	char[8]  magic "CPUVHSNP"
+//	int32    version
+//	int32    0x01020304, written in native byte order
+//	int32    nx, ny, nz, the cells written along x, y and eta
+//	int32    bytes per value (sizeof(PRECISION))
+//	int32    number of fields
+//	int32    length of the field names including the terminating zero
+//	double   x0, y0, z0, the position of the first cell written [fm, fm, 1]
+//	double   dx, dy, dz, the distance between the cells written [fm, fm, 1]
+//	char[]   field names, space separated
+// is followed by the snapshots until the end of the file, each
+//	double   tau [fm]
+//	int64    bit f is set if field f is in the snapshot
+//	value[]  the fields in the snapshot one after the other, each nx*ny*nz values with x fastest, then y, then z
+// the cell (i, j, k) is at x = x0 + i dx, y = y0 + j dy, z = z0 + k dz.
+// version 1 had the physical lattice points in nx, ny, nz, no x0, y0, z0 and no field bits (all fields in each snapshot)
+#define SNAPSHOT_BINARY_MAGIC "CPUVHSNP"
+#define SNAPSHOT_BINARY_VERSION 2
+
+#define MAX_SNAPSHOT_FIELDS 32
+
+typedef struct
+{
+	// the cells written, every stride[a]-th cell of the lattice along axis a from the cell first[a]
+	int nx, ny, nz;
+	int first[3], stride[3];
+	int latticeNx, latticeNy; // the physical lattice points
+	double x0, y0, z0;
+	double dx, dy, dz;
+	int numberOfFields;
+	const char *names[MAX_SNAPSHOT_FIELDS];
+	FILE *file;
+	char *buffer; // stdio buffer of file
+	long numberOfSnapshots;
+} SNAPSHOT_FILE;
+
+// the cells and the names of the fields of the snapshots: the cells of the lattice in the ranges [min, max] of
+// x, y and eta, and of them every decimation-th along each axis, counted from the center of the lattice.
+// The file is opened by openSnapshotFile
+void initializeSnapshotFile(SNAPSHOT_FILE * const snapshot, void * latticeParams, int numberOfFields, const char * const * names,
+		const double * const xRange, const double * const yRange, const double * const rapidityRange, int decimation);
+
+// path of the snapshot file in directory: snapshots.bin, or snapshot_<tau>.bin for SNAPSHOT_FORMAT_BINARY
+void snapshotFilePath(char *path, const char *directory, int format, double t);
+
+void openSnapshotFile(SNAPSHOT_FILE * const snapshot, const char *path);
+
+// number of cells written, nx * ny * nz
+size_t snapshotCells(const SNAPSHOT_FILE * const snapshot);
+
+// index on the lattice with ghost cells of the cell (i, j, k) of the snapshot
+inline int snapshotLatticeIndex(const SNAPSHOT_FILE * const snapshot, int i, int j, int k) {
+	return columnMajorLinearIndex(2 + snapshot->first[0] + i * snapshot->stride[0], 2 + snapshot->first[1] + j * snapshot->stride[1],
+			2 + snapshot->first[2] + k * snapshot->stride[2], snapshot->latticeNx + 4, snapshot->latticeNy + 4);
+}
+
+// copy the cells of the snapshot of field (on the lattice with ghost cells) to values, in the order of the file
+void gatherSnapshotField(const SNAPSHOT_FILE * const snapshot, const PRECISION * const field, PRECISION * const values);
+
+// append the snapshot at time t of the fields in mask, whose snapshotCells values are one after the other in values
+void writeSnapshot(SNAPSHOT_FILE * const snapshot, double t, uint64_t mask, const PRECISION * const values);
+
+void closeSnapshotFile(SNAPSHOT_FILE * const snapshot);
+
+// asynchronous output: the time loop fills one of numberOfBuffers staging buffers with the fields and hands it to a
+// writer thread, which writes it in the format of the writer while the hydro evolves the next steps. The time loop
+// waits only when all the buffers are queued, so at most numberOfBuffers snapshots are held in memory
+typedef struct
+{
+	SNAPSHOT_FILE file;
+	int format;
+	const char *directory;
+	int numberOfBuffers;
+	PRECISION **buffers;
+	double *times;
+	uint64_t *masks;
+	int head, count; // the oldest queued buffer, which is the one being written, and the number of queued buffers
+	int quit;
+	pthread_t thread;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	double waitTime; // time the hydro has spent waiting for a free buffer [s]
+} SNAPSHOT_WRITER;
+
+// start the writer of file, initialized by initializeSnapshotFile, to directory; a SNAPSHOT_FORMAT_BINARY_APPEND file
+// is opened at once
+void startSnapshotWriter(SNAPSHOT_WRITER * const writer, const SNAPSHOT_FILE * const file, int format, const char *directory,
+		double t0, int numberOfBuffers);
+
+// start the writer of a checkpointed run (see HydroPlugin.cpp), which had written numberOfSnapshots snapshots, and
+// offset bytes of the SNAPSHOT_FORMAT_BINARY_APPEND file, at the checkpoint. What was written after it is cut off
+void resumeSnapshotWriter(SNAPSHOT_WRITER * const writer, const SNAPSHOT_FILE * const file, int format, const char *directory,
+		double t0, int numberOfBuffers, long offset, long numberOfSnapshots);
+
+// wait for the queued snapshots to be written; returns the size of the SNAPSHOT_FORMAT_BINARY_APPEND file, for a
+// checkpoint
+long snapshotWriterOffset(SNAPSHOT_WRITER * const writer);
+
+// a free staging buffer of numberOfFields * snapshotCells values; waits for one if all are queued
+PRECISION * acquireSnapshotBuffer(SNAPSHOT_WRITER * const writer);
+
+// queue the buffer of the last acquireSnapshotBuffer, holding the snapshot of the fields in mask at time t
+void queueSnapshot(SNAPSHOT_WRITER * const writer, double t, uint64_t mask);
+
+// write the queued snapshots, stop the writer and close the file
+void finishSnapshotWriter(SNAPSHOT_WRITER * const writer);
+
+#endif /* SNAPSHOTFILE_H_ */
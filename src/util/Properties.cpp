@@ -5,6 +5,9 @@
  *      Author: bazow
  */
 
+#include <stdlib.h>
+#include <stdio.h>
+
 #include "../util/Properties.h"
 
 void getIntegerProperty(config_t *cfg, const char* propName, int *propValue, int defaultValue) {
@@ -20,3 +23,57 @@ void getDoubleProperty(config_t *cfg, const char* propName, double *propValue, d
 	  else
 	    *propValue = defaultValue;
 }
+
+// the value of a number setting; libconfig reads an integer as float 0
+static int getNumberSetting(const config_setting_t *setting, double *value) {
+	  switch(config_setting_type(setting)) {
+	  case CONFIG_TYPE_FLOAT:
+	    *value = config_setting_get_float(setting);
+	    return 1;
+	  case CONFIG_TYPE_INT:
+	    *value = config_setting_get_int(setting);
+	    return 1;
+	  case CONFIG_TYPE_INT64:
+	    *value = (double) config_setting_get_int64(setting);
+	    return 1;
+	  default:
+	    return 0;
+	  }
+}
+
+int getDoubleArrayProperty(config_t *cfg, const char* propName, double *propValues, int maxValues) {
+	  config_setting_t *setting = config_lookup(cfg, propName);
+	  if(!setting)
+	    return 0;
+	  // a scalar has length 0, which would read as not set
+	  if(!config_setting_is_array(setting) && !config_setting_is_list(setting)) {
+	    printf("%s must be an array [x, y, ...]!\n", propName);
+	    exit(-1);
+	  }
+	  int n = config_setting_length(setting);
+	  if(n > maxValues) {
+	    fprintf(stderr, "Only the first %d values of %s are used.\n", maxValues, propName);
+	    n = maxValues;
+	  }
+	  for(int i = 0; i < n; ++i) {
+	    if(!getNumberSetting(config_setting_get_elem(setting, i), &propValues[i])) {
+	      printf("Element %d of %s is not a number!\n", i, propName);
+	      exit(-1);
+	    }
+	  }
+	  return n;
+}
+
+int getStringArrayProperty(config_t *cfg, const char* propName, const char **propValues, int maxValues) {
+	  config_setting_t *setting = config_lookup(cfg, propName);
+	  if(!setting)
+	    return 0;
+	  int n = config_setting_length(setting);
+	  if(n > maxValues) {
+	    fprintf(stderr, "Only the first %d values of %s are used.\n", maxValues, propName);
+	    n = maxValues;
+	  }
+	  for(int i = 0; i < n; ++i)
+	    propValues[i] = config_setting_get_string_elem(setting, i);
+	  return n;
+}
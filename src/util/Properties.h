@@ -12,5 +12,10 @@
 
 void getIntegerProperty(config_t *cfg, const char* propName, int *propValue, int defaultValue);
 void getDoubleProperty(config_t *cfg, const char* propName, double *propValue, double defaultValue);
+// reads at most maxValues elements of an array property [x, y, ...] of integers or floats; returns the number read,
+// 0 if not set. A setting that is not an array, or an element that is not a number, is an error
+int getDoubleArrayProperty(config_t *cfg, const char* propName, double *propValues, int maxValues);
+// reads at most maxValues elements of an array property ["a", "b", ...]; the strings belong to cfg
+int getStringArrayProperty(config_t *cfg, const char* propName, const char **propValues, int maxValues);
 
 #endif /* PROPERTIES_H_ */
@@ -0,0 +1,169 @@
+"""Reader for the binary freezeout surface files written by cpu-vh
+(freezeoutFormat 1 and 2 in output.properties, see src/freezeout/FreezeoutSurfaceFile.h
+for the layout), and converter to the iS3D ASCII layout of surface.dat.
+
+The surface can also be consumed while the hydro runs: with --fifo or
+--socket the reader creates a named pipe or listens on a Unix domain socket
+at the path of the surface file (e.g. output/surface.bin), which cpu-vh then
+writes to instead of a file.
+
+usage: python freezeout_surface.py surface.bin[.gz] [surface.dat]
+       python freezeout_surface.py --fifo|--socket output/surface.bin[.gz] [surface.dat]
+"""
+
+import gzip
+import os
+import socket
+import struct
+import sys
+
+import numpy as np
+
+MAGIC = b'CPUVHFOS'
+SUPPORTED_VERSION = 1
+
+
+def _parse_header(read, name):
+    """Read the header with read(n) -> bytes; return (header, dtype)."""
+    if read(8) != MAGIC:
+        raise ValueError('%s is not a freezeout surface file' % name)
+    fields = read(24)
+    # the byte order of the file follows from the 0x01020304 marker
+    for order in '<>':
+        version, marker, dim, columns, value_size, schema_length = struct.unpack(order + '6i', fields)
+        if marker == 0x01020304:
+            break
+    else:
+        raise ValueError('%s: unknown byte order' % name)
+    if version > SUPPORTED_VERSION:
+        raise ValueError('%s: version %d is newer than this reader' % (name, version))
+
+    schema = read(schema_length)[:-1].decode('ascii').split()
+    dtype = np.dtype(order + {4: 'f4', 8: 'f8'}[value_size])
+    header = {'version': version, 'dim': dim, 'columns': columns, 'schema': schema}
+    return header, dtype
+
+
+def read_surface(filename):
+    """Return (header, elements): a dict with the header fields and an
+    (elements x columns) array in the units of header['schema']."""
+    with open(filename, 'rb') as f:
+        compressed = f.read(2) == b'\x1f\x8b'
+    opener = gzip.open if compressed else open
+    with opener(filename, 'rb') as f:
+        data = f.read()
+
+    offset = [0]
+
+    def read(n):
+        offset[0] += n
+        return data[offset[0] - n:offset[0]]
+
+    header, dtype = _parse_header(read, filename)
+    elements = np.frombuffer(data, dtype=dtype, offset=offset[0]).reshape(-1, header['columns'])
+    return header, elements.astype(np.float64)
+
+
+def stream_surface(stream, name='stream', chunk_elements=4096):
+    """Read a surface from a binary stream (pipe, socket or file object) as
+    it is written. Yield (header, elements) for every chunk of at most
+    chunk_elements elements that has arrived, until the writer closes it."""
+    magic = stream.read(2)
+    stream = _Prefixed(magic, stream)
+    if magic == b'\x1f\x8b':
+        stream = gzip.GzipFile(fileobj=stream)
+
+    def read(n):
+        data = b''
+        while len(data) < n:
+            more = stream.read(n - len(data))
+            if not more:
+                raise EOFError('%s: incomplete header' % name)
+            data += more
+        return data
+
+    header, dtype = _parse_header(read, name)
+    record = header['columns'] * dtype.itemsize
+    pending = b''
+    # read1 returns what has arrived instead of waiting for a full chunk
+    read_some = getattr(stream, 'read1', stream.read)
+    while True:
+        data = read_some(chunk_elements * record - len(pending))
+        if not data:
+            break
+        pending += data
+        complete = len(pending) - len(pending) % record
+        if complete:
+            elements = np.frombuffer(pending[:complete], dtype=dtype).reshape(-1, header['columns'])
+            pending = pending[complete:]
+            yield header, elements.astype(np.float64)
+    if pending:
+        raise EOFError('%s: truncated element' % name)
+
+
+class _Prefixed(object):
+    """File object that returns prefix before the rest of stream."""
+
+    def __init__(self, prefix, stream):
+        self.prefix = prefix
+        self.stream = stream
+
+    def read(self, n=-1):
+        if self.prefix:
+            data, self.prefix = self.prefix, b''
+            return data if n < 0 or n >= len(data) else data[:n]
+        return self.stream.read(n)
+
+    def read1(self, n=-1):
+        if self.prefix:
+            return self.read(n)
+        return getattr(self.stream, 'read1', self.stream.read)(n)
+
+
+def open_stream(path, kind):
+    """Create a named pipe (kind 'fifo') or listen on a Unix domain socket
+    (kind 'socket') at path and return a binary file object once cpu-vh has
+    opened it."""
+    if os.path.exists(path):
+        os.remove(path)
+    if kind == 'fifo':
+        os.mkfifo(path)
+        return open(path, 'rb')
+    server = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+    server.bind(path)
+    server.listen(1)
+    connection, _ = server.accept()
+    server.close()
+    return connection.makefile('rb')
+
+
+def write_ascii(elements, filename):
+    """Write the elements in the iS3D ASCII layout, one element per line."""
+    np.savetxt(filename, elements, fmt='%g', delimiter=' ')
+
+
+if __name__ == '__main__':
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    if sys.argv[1] in ('--fifo', '--socket'):
+        if len(sys.argv) < 3:
+            sys.exit(__doc__)
+        path = sys.argv[2]
+        stream = open_stream(path, sys.argv[1][2:])
+        output = open(sys.argv[3], 'w') if len(sys.argv) > 3 else None
+        count = 0
+        for header, elements in stream_surface(stream, path):
+            count += len(elements)
+            print('%d elements, tau = %g fm' % (count, elements[-1, 0]))
+            if output:
+                np.savetxt(output, elements, fmt='%g', delimiter=' ')
+        stream.close()
+        os.remove(path)
+        if output:
+            output.close()
+        sys.exit(0)
+    header, elements = read_surface(sys.argv[1])
+    print('version %d, %d+1D, %d elements' % (header['version'], header['dim'] - 1, len(elements)))
+    print(' '.join(header['schema']))
+    if len(sys.argv) > 2:
+        write_ascii(elements, sys.argv[2])
@@ -0,0 +1,92 @@
+"""Converter of the ASCII initial conditions of cpu-vh (initialConditionType
+10 and 11 in ic.properties) to the binary initial condition input/Tmunu.bin
+(initialConditionType 12, see src/ic/InitialConditionFile.h): a snapshot
+file of the whole lattice, which is read without parsing.
+
+The values are written as float, the precision the ASCII files are read
+with, unless --double is given. Models can also write Tmunu.bin directly,
+with write_initial_condition. tau, the time of the initial conditions, is
+checked against initialProperTimePoint by the hydro unless it is 0.
+
+usage: python initial_condition.py [--double] input/Tmunu.dat input/Tmunu.bin [tau]
+       python initial_condition.py [--double] input/ input/Tmunu.bin [tau]   (input/e.dat, input/p.dat, ...)
+"""
+
+import os
+import struct
+import sys
+
+import numpy as np
+
+MAGIC = b'CPUVHSNP'
+VERSION = 2
+
+# the columns of Tmunu.dat after x, y, z, which are also the field names of Tmunu.bin
+FIELDS = ['e', 'p', 'ut', 'ux', 'uy', 'un', 'pitt', 'pitx', 'pity', 'pitn', 'pixx', 'pixy', 'pixn', 'piyy', 'piyn',
+          'pinn', 'Pi']
+# the files of initialConditionType 10, by field
+FILES = dict([(name, name + '.dat') for name in FIELDS[:-1]] + [('Pi', 'bulk.dat')])
+
+
+def write_initial_condition(filename, tau, x, y, z, fields, value_type=np.float32):
+    """Write the fields, a dict of arrays values[nz, ny, nx] of the cells at
+    x[nx], y[ny], z[nz] (the whole lattice), at time tau to filename."""
+    names = [name for name in FIELDS if name in fields] + [name for name in fields if name not in FIELDS]
+    nx, ny, nz = len(x), len(y), len(z)
+    spacings = [(a[1] - a[0]) if len(a) > 1 else 0.0 for a in (x, y, z)]
+    names_bytes = ' '.join(names).encode('ascii') + b'\0'
+    value_type = np.dtype(value_type).newbyteorder('=')
+    with open(filename, 'wb') as f:
+        f.write(MAGIC)
+        f.write(struct.pack('=8i', VERSION, 0x01020304, nx, ny, nz, value_type.itemsize, len(names), len(names_bytes)))
+        f.write(struct.pack('=6d', x[0], y[0], z[0], *spacings))
+        f.write(names_bytes)
+        f.write(struct.pack('=dQ', tau, (1 << len(names)) - 1))
+        for name in names:
+            f.write(np.ascontiguousarray(fields[name], dtype=value_type).reshape(nz, ny, nx).tobytes())
+
+
+def _lattice(x, y, z):
+    """The coordinates of the lattice of the rows, which list the cells with
+    x slowest and eta fastest, and the order of the rows in the file layout."""
+    axes = [np.unique(a) for a in (x, y, z)]
+    nx, ny, nz = (len(a) for a in axes)
+    if nx * ny * nz != len(x):
+        raise ValueError('the %d rows are not the cells of a lattice' % len(x))
+    return axes, (nx, ny, nz)
+
+
+def read_ascii(path):
+    """Return (x, y, z, fields) of Tmunu.dat or of the directory with
+    e.dat, p.dat, ..."""
+    fields = {}
+    if os.path.isdir(path):
+        for name, file in FILES.items():
+            filename = os.path.join(path, file)
+            if not os.path.exists(filename):
+                continue
+            x, y, z, fields[name] = np.loadtxt(filename, unpack=True, dtype=np.float64)
+    else:
+        columns = np.loadtxt(path, unpack=True, dtype=np.float64)
+        x, y, z = columns[:3]
+        for name, values in zip(FIELDS, columns[3:]):
+            fields[name] = values
+    axes, (nx, ny, nz) = _lattice(x, y, z)
+    # the ASCII files have eta fastest, the snapshot files x fastest
+    for name in fields:
+        fields[name] = fields[name].reshape(nx, ny, nz).transpose(2, 1, 0)
+    return axes[0], axes[1], axes[2], fields
+
+
+if __name__ == '__main__':
+    args = sys.argv[1:]
+    value_type = np.float32
+    if args and args[0] == '--double':
+        value_type = np.float64
+        args = args[1:]
+    if len(args) < 2:
+        sys.exit(__doc__)
+    x, y, z, fields = read_ascii(args[0])
+    tau = float(args[2]) if len(args) > 2 else 0.0
+    write_initial_condition(args[1], tau, x, y, z, fields, value_type)
+    print('%d x %d x %d cells of %s written to %s' % (len(x), len(y), len(z), ' '.join(fields), args[1]))